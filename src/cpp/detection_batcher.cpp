@@ -0,0 +1,132 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  15:38:02
+// @Brief  : This is common class.
+// @File    : detection_batcher.cpp
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : 
+
+#include "detection_batcher.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+
+/**
+ * The DetectionBatcher constructor starts the batch thread, the only thread that runs the predictor.
+ *
+ * @param swapper The holder of the current predictor, it must outlive the batcher.
+ * @param config The batch size, wait time and queue limits.
+ */
+DetectionBatcher::DetectionBatcher(ModelSwapper& swapper, const BatcherConfig& config)
+    : swapper(swapper), config(config), stopping(false), queue_ms_sum(0.0), batch_ms_sum(0.0) {
+    this->config.max_batch = std::max(config.max_batch, 1);
+    std::memset(&stats, 0, sizeof(stats));
+    worker = std::thread(&DetectionBatcher::run, this);
+}
+
+/**
+ * The destructor finishes the queued images, then stops the batch thread.
+ */
+DetectionBatcher::~DetectionBatcher() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    cond.notify_all();
+    worker.join();
+}
+
+/**
+ * The function `submit` queues a decoded image for detection without blocking.
+ *
+ * @param image The decoded image, see `decode_image`.
+ * @param result Receives the future detections of the image.
+ *
+ * @return false if the queue is full, the caller should reject the request.
+ */
+bool DetectionBatcher::submit(const DecodedImage& image, std::future<ResultData>& result) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping || queue.size() >= config.max_queue) {
+            ++stats.rejected;
+            return false;
+        }
+        queue.emplace_back();
+        Job& job = queue.back();
+        job.image = image;
+        job.enqueued = std::chrono::steady_clock::now();
+        result = job.promise.get_future();
+        ++stats.requests;
+        stats.peak_queue_depth = std::max(stats.peak_queue_depth, queue.size());
+    }
+    cond.notify_one();
+    return true;
+}
+
+BatcherStats DetectionBatcher::get_stats() {
+    std::lock_guard<std::mutex> lock(mutex);
+    BatcherStats out = stats;
+    out.queue_depth = queue.size();
+    out.mean_batch = stats.batches > 0 ? (double)stats.batched_images / stats.batches : 0.0;
+    out.mean_queue_ms = stats.batched_images > 0 ? queue_ms_sum / stats.batched_images : 0.0;
+    out.mean_batch_ms = stats.batches > 0 ? batch_ms_sum / stats.batches : 0.0;
+    return out;
+}
+
+/**
+ * The batch loop. A batch is closed when it is full or when its first image has waited `max_wait_us`,
+ * so a lone request pays at most that much extra latency, while concurrent requests share a round of
+ * the predictor's request pool.
+ */
+void DetectionBatcher::run() {
+    std::vector<Job> batch;
+    std::vector<ImageView> views;
+    for (;;) {
+        batch.clear();
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cond.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (queue.empty()) {
+                return;
+            }
+            auto deadline = queue.front().enqueued + std::chrono::microseconds(config.max_wait_us);
+            cond.wait_until(lock, deadline, [this] { return stopping || (int)queue.size() >= config.max_batch; });
+            size_t n = std::min(queue.size(), (size_t)config.max_batch);
+            auto now = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < n; ++i) {
+                queue_ms_sum += std::chrono::duration<double, std::milli>(now - queue.front().enqueued).count();
+                batch.push_back(std::move(queue.front()));
+                queue.pop_front();
+            }
+        }
+        views.clear();
+        for (Job& job : batch) {
+            views.push_back(job.image.view());
+        }
+        auto start = std::chrono::steady_clock::now();
+        // The jobs given their result, only the rest get the exception: a promise is satisfied once.
+        size_t done = 0;
+        try {
+            // The batch keeps the predictor it started on alive, a model swap waits for it to drain.
+            std::shared_ptr<RTDETRPredictor> predictor = swapper.acquire();
+            std::vector<ResultData> results = predictor->detect_batch(views);
+            for (; done < batch.size(); ++done) {
+                batch[done].promise.set_value(std::move(results[done]));
+            }
+        }
+        catch (...) {
+            for (size_t i = done; i < batch.size(); ++i) {
+                batch[i].promise.set_exception(std::current_exception());
+            }
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::lock_guard<std::mutex> lock(mutex);
+        ++stats.batches;
+        stats.batched_images += batch.size();
+        batch_ms_sum += ms;
+    }
+}
@@ -0,0 +1,78 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  15:31:37
+// @Brief  : This is common class.
+// @File    : detection_batcher.h
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : Coalesces concurrent detection requests into micro-batches for the current predictor.
+#ifndef __DETECTION_BATCHER_H__
+#define __DETECTION_BATCHER_H__
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+
+#include "opencv2/opencv.hpp"
+#include "image_decoder.h"
+#include "model_swapper.h"
+#include "rtdert_predictor.h"
+
+struct BatcherConfig {
+    int max_batch;              // The most images of a batch, usually the request pool size.
+    int max_wait_us;            // How long the first image of a batch waits for more to arrive.
+    size_t max_queue;           // The images that may wait, `submit` rejects beyond it.
+    BatcherConfig() : max_batch(4), max_wait_us(2000), max_queue(64) {}
+};
+
+struct BatcherStats {
+    uint64_t requests;          // The accepted images.
+    uint64_t rejected;          // The images rejected because the queue was full.
+    uint64_t batches;
+    uint64_t batched_images;
+    size_t queue_depth;
+    size_t peak_queue_depth;
+    double mean_batch;
+    double mean_queue_ms;       // The mean time from `submit` to the start of the batch.
+    double mean_batch_ms;       // The mean inference time of a batch.
+};
+
+class DetectionBatcher
+{
+public:
+    DetectionBatcher(ModelSwapper& swapper, const BatcherConfig& config);
+    ~DetectionBatcher();
+    bool submit(const DecodedImage& image, std::future<ResultData>& result);
+    BatcherStats get_stats();
+
+private:
+    DetectionBatcher(const DetectionBatcher&);
+    DetectionBatcher& operator=(const DetectionBatcher&);
+    void run();
+
+    struct Job {
+        DecodedImage image;
+        std::promise<ResultData> promise;
+        std::chrono::steady_clock::time_point enqueued;
+    };
+
+private:
+    ModelSwapper& swapper;          // Its predictors are only used by the batch thread.
+    BatcherConfig config;
+    std::deque<Job> queue;
+    std::mutex mutex;
+    std::condition_variable cond;
+    bool stopping;
+    BatcherStats stats;
+    double queue_ms_sum;
+    double batch_ms_sum;
+    std::thread worker;
+};
+
+#endif // !__DETECTION_BATCHER_H__
@@ -0,0 +1,501 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  15:47:15
+// @Brief  : This is common class.
+// @File    : http_server.cpp
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : A local HTTP/1.1 inference endpoint. The encoded images are decoded on an I/O
+//                thread pool and coalesced into micro-batches for the resident predictor.
+//
+//                POST /detect       The body is an encoded image (JPEG, PNG, ...). The detections are
+//                                   returned as JSON, or as binary records with `?format=binary` or
+//                                   `Accept: application/octet-stream`.
+//                GET  /metrics      The queue depths, batch, reload and memory statistics as JSON.
+//                GET  /health       200 while the server runs.
+//                POST /reload       Swaps in a new model without dropping requests. The body is the
+//                                   path of a model bundle under the reload root, or empty to reload
+//                                   the current files. Disabled unless the server has a reload root.
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "detection_batcher.h"
+#include "image_decoder.h"
+#include "model_bundle.h"
+#include "model_swapper.h"
+#include "rtdert_predictor.h"
+#include "thread_pool.h"
+
+
+static const size_t MAX_HEADER_BYTES = 16 * 1024;
+static const size_t MAX_BODY_BYTES = 32 * 1024 * 1024;
+// A keep-alive connection holds an I/O thread while it waits, so it is closed after this many
+// requests or this idle time.
+static const int MAX_CONNECTION_REQUESTS = 100;
+static const int IDLE_TIMEOUT_SECONDS = 5;
+
+static volatile std::sig_atomic_t stop_flag = 0;
+
+static void on_signal(int) {
+    stop_flag = 1;
+}
+
+struct HttpRequest {
+    std::string method;
+    std::string path;
+    std::string query;
+    std::map<std::string, std::string> headers;     // The header names are lower case.
+    std::string body;
+    bool keep_alive;
+};
+
+// A detection of the binary response, little-endian, after a uint32 count.
+struct BinaryDetection {
+    int32_t clsid;
+    float score;
+    float x, y, width, height;
+};
+
+static std::string to_lower(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+    return s;
+}
+
+static std::string trim(const std::string& s) {
+    size_t b = s.find_first_not_of(" \t");
+    size_t e = s.find_last_not_of(" \t\r");
+    return b == std::string::npos ? std::string() : s.substr(b, e - b + 1);
+}
+
+/**
+ * The function reads one request from a connection. Bytes beyond the request (a pipelined request)
+ * stay in `buffer` for the next call.
+ *
+ * @return 0 on success, -1 if the connection was closed or timed out, or an HTTP error status.
+ */
+static int read_request(int fd, std::string& buffer, HttpRequest& request) {
+    char chunk[16 * 1024];
+    size_t header_end;
+    while ((header_end = buffer.find("\r\n\r\n")) == std::string::npos) {
+        if (buffer.size() > MAX_HEADER_BYTES) {
+            return 431;
+        }
+        ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+        if (n <= 0) {
+            return -1;
+        }
+        buffer.append(chunk, (size_t)n);
+    }
+    std::istringstream head(buffer.substr(0, header_end));
+    std::string line, version;
+    std::getline(head, line);
+    std::istringstream request_line(line);
+    std::string target;
+    request_line >> request.method >> target >> version;
+    size_t q = target.find('?');
+    request.path = target.substr(0, q);
+    request.query = q == std::string::npos ? std::string() : target.substr(q + 1);
+    request.headers.clear();
+    while (std::getline(head, line)) {
+        size_t colon = line.find(':');
+        if (colon != std::string::npos) {
+            request.headers[to_lower(trim(line.substr(0, colon)))] = trim(line.substr(colon + 1));
+        }
+    }
+    std::string connection = to_lower(request.headers["connection"]);
+    request.keep_alive = version == "HTTP/1.1" ? connection != "close" : connection == "keep-alive";
+
+    size_t length = 0;
+    if (request.headers.count("content-length")) {
+        length = (size_t)std::strtoull(request.headers["content-length"].c_str(), nullptr, 10);
+    }
+    if (request.headers.count("transfer-encoding")) {
+        return 411;
+    }
+    if (length > MAX_BODY_BYTES) {
+        return 413;
+    }
+    buffer.erase(0, header_end + 4);
+    while (buffer.size() < length) {
+        ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+        if (n <= 0) {
+            return -1;
+        }
+        buffer.append(chunk, (size_t)n);
+    }
+    request.body.assign(buffer, 0, length);
+    buffer.erase(0, length);
+    return 0;
+}
+
+static bool send_all(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t n = send(fd, data, size, MSG_NOSIGNAL);
+        if (n <= 0) {
+            return false;
+        }
+        data += n;
+        size -= (size_t)n;
+    }
+    return true;
+}
+
+static const char* status_text(int status) {
+    switch (status) {
+    case 200: return "OK";
+    case 202: return "Accepted";
+    case 400: return "Bad Request";
+    case 403: return "Forbidden";
+    case 404: return "Not Found";
+    case 405: return "Method Not Allowed";
+    case 409: return "Conflict";
+    case 411: return "Length Required";
+    case 413: return "Payload Too Large";
+    case 431: return "Request Header Fields Too Large";
+    case 503: return "Service Unavailable";
+    default: return "Internal Server Error";
+    }
+}
+
+static bool send_response(int fd, int status, const std::string& content_type, const std::string& body,
+    bool keep_alive) {
+    std::ostringstream head;
+    head << "HTTP/1.1 " << status << " " << status_text(status) << "\r\n"
+        << "Content-Type: " << content_type << "\r\n"
+        << "Content-Length: " << body.size() << "\r\n"
+        << "Connection: " << (keep_alive ? "keep-alive" : "close") << "\r\n";
+    if (status == 503) {
+        head << "Retry-After: 1\r\n";
+    }
+    head << "\r\n";
+    std::string text = head.str();
+    return send_all(fd, text.data(), text.size()) && send_all(fd, body.data(), body.size());
+}
+
+static bool send_error(int fd, int status, const std::string& message, bool keep_alive) {
+    return send_response(fd, status, "application/json", "{\"error\":\"" + message + "\"}", keep_alive);
+}
+
+static std::string json_escape(const std::string& s) {
+    std::string out;
+    for (unsigned char c : s) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += (char)c;
+        } else if (c < 0x20) {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+            out += buf;
+        } else {
+            out += (char)c;
+        }
+    }
+    return out;
+}
+
+static std::string result_to_json(const ResultData& result) {
+    std::ostringstream out;
+    out << "{\"detections\":[";
+    for (size_t i = 0; i < result.clsids.size(); ++i) {
+        const cv::Rect& b = result.bboxs[i];
+        out << (i ? "," : "") << "{\"class_id\":" << result.clsids[i]
+            << ",\"label\":\"" << json_escape(result.labels[i]) << "\""
+            << ",\"score\":" << result.scores[i]
+            << ",\"bbox\":[" << b.x << "," << b.y << "," << b.width << "," << b.height << "]}";
+    }
+    out << "]}";
+    return out.str();
+}
+
+static std::string result_to_binary(const ResultData& result) {
+    uint32_t count = (uint32_t)result.clsids.size();
+    std::string out(sizeof(count) + count * sizeof(BinaryDetection), '\0');
+    std::memcpy(&out[0], &count, sizeof(count));
+    for (uint32_t i = 0; i < count; ++i) {
+        BinaryDetection d;
+        d.clsid = result.clsids[i];
+        d.score = result.scores[i];
+        d.x = (float)result.bboxs[i].x;
+        d.y = (float)result.bboxs[i].y;
+        d.width = (float)result.bboxs[i].width;
+        d.height = (float)result.bboxs[i].height;
+        std::memcpy(&out[sizeof(count) + i * sizeof(d)], &d, sizeof(d));
+    }
+    return out;
+}
+
+static std::string metrics_to_json(DetectionBatcher& batcher, ModelSwapper& swapper, ThreadPool& io_pool,
+    const std::atomic<uint64_t>& rejected_connections) {
+    BatcherStats s = batcher.get_stats();
+    SwapStats w = swapper.get_stats();
+    MemoryStats m = swapper.acquire()->get_memory_stats();
+    std::ostringstream out;
+    out << "{\"requests\":" << s.requests
+        << ",\"rejected\":" << s.rejected
+        << ",\"rejected_connections\":" << rejected_connections.load()
+        << ",\"queue_depth\":" << s.queue_depth
+        << ",\"peak_queue_depth\":" << s.peak_queue_depth
+        << ",\"io_queue_depth\":" << io_pool.queue_depth()
+        << ",\"batches\":" << s.batches
+        << ",\"mean_batch\":" << s.mean_batch
+        << ",\"mean_queue_ms\":" << s.mean_queue_ms
+        << ",\"mean_batch_ms\":" << s.mean_batch_ms
+        << ",\"model_generation\":" << w.generation
+        << ",\"reloading\":" << (w.reloading ? "true" : "false")
+        << ",\"reload_load_ms\":" << w.load_ms
+        << ",\"reload_warmup_ms\":" << w.warmup_ms
+        << ",\"reload_swap_us\":" << w.swap_us
+        << ",\"reload_drain_ms\":" << w.drain_ms
+        << ",\"rss_bytes\":" << m.rss
+        << ",\"peak_rss_bytes\":" << m.peak_rss
+        << ",\"weight_bytes\":" << m.weight_bytes
+        << ",\"tensor_bytes\":" << m.tensor_bytes
+        << ",\"reload_error\":\"" << json_escape(w.error) << "\"}";
+    return out.str();
+}
+
+/**
+ * The function resolves a path to its canonical form, following the symbolic links.
+ *
+ * @return the canonical path, empty if it does not exist.
+ */
+static std::string canonical_path(const std::string& path) {
+    char* resolved = realpath(path.c_str(), nullptr);
+    if (resolved == nullptr) {
+        return std::string();
+    }
+    std::string out(resolved);
+    free(resolved);
+    return out;
+}
+
+/**
+ * The function resolves a bundle path of /reload, relative paths are taken from the reload root.
+ *
+ * @return the canonical path, empty if it does not exist or lies outside the root.
+ */
+static std::string resolve_bundle_path(const std::string& reload_root, const std::string& path) {
+    std::string resolved = canonical_path(path[0] == '/' ? path : reload_root + "/" + path);
+    std::string prefix = reload_root.back() == '/' ? reload_root : reload_root + "/";
+    if (resolved != reload_root && resolved.compare(0, prefix.size(), prefix) != 0) {
+        return std::string();
+    }
+    return resolved;
+}
+
+/**
+ * The function starts a model swap. It answers 202 at once, the progress shows in /metrics.
+ *
+ * @param reload_root The canonical directory the bundles are loaded from, empty to disable /reload.
+ */
+static bool serve_reload(int fd, const HttpRequest& request, ModelSwapper& swapper,
+    const std::string& reload_root, bool keep_alive) {
+    if (request.method != "POST") {
+        return send_error(fd, 405, "use POST", keep_alive);
+    }
+    if (reload_root.empty()) {
+        return send_error(fd, 403, "reload is disabled, the server has no reload root", keep_alive);
+    }
+    bool started;
+    try {
+        std::string path = request.body;
+        path.erase(path.find_last_not_of(" \r\n\t") + 1);
+        if (path.empty()) {
+            started = swapper.reload();
+        } else {
+            std::string resolved = resolve_bundle_path(reload_root, path);
+            if (resolved.empty()) {
+                return send_error(fd, 403, "the bundle is not under the reload root", keep_alive);
+            }
+            started = swapper.reload(load_bundle(resolved));
+        }
+    }
+    catch (const std::exception& e) {
+        return send_error(fd, 400, json_escape(e.what()), keep_alive);
+    }
+    if (!started) {
+        return send_error(fd, 409, "a reload is already running", keep_alive);
+    }
+    return send_response(fd, 202, "application/json", "{\"status\":\"reloading\"}", keep_alive);
+}
+
+/**
+ * The function serves the requests of one connection on an I/O thread. The image is decoded here, so
+ * the batch thread only runs inference.
+ */
+static void serve_connection(int fd, DetectionBatcher& batcher, ModelSwapper& swapper, ThreadPool& io_pool,
+    const std::string& reload_root, const std::atomic<uint64_t>& rejected_connections) {
+    std::string buffer;
+    HttpRequest request;
+    int served = 0;
+    for (bool keep_alive = true; keep_alive && !stop_flag; ) {
+        int status = read_request(fd, buffer, request);
+        if (status < 0) {
+            break;
+        }
+        if (status > 0) {
+            send_error(fd, status, status_text(status), false);
+            break;
+        }
+        // The connection is closed after its last allowed request, or at once when other connections
+        // wait for an I/O thread, so that keep-alive clients cannot starve the pool.
+        keep_alive = request.keep_alive && ++served < MAX_CONNECTION_REQUESTS && io_pool.queue_depth() == 0;
+        bool sent;
+        if (request.path == "/health") {
+            sent = send_response(fd, 200, "application/json", "{\"status\":\"ok\"}", keep_alive);
+        } else if (request.path == "/metrics") {
+            sent = send_response(fd, 200, "application/json",
+                metrics_to_json(batcher, swapper, io_pool, rejected_connections), keep_alive);
+        } else if (request.path == "/reload") {
+            sent = serve_reload(fd, request, swapper, reload_root, keep_alive);
+        } else if (request.path != "/detect") {
+            sent = send_error(fd, 404, "unknown path", keep_alive);
+        } else if (request.method != "POST") {
+            sent = send_error(fd, 405, "use POST", keep_alive);
+        } else {
+            // JPEGs are decoded near the model input size, the detections stay in the full size.
+            DecodedImage image;
+            if (!request.body.empty()) {
+                try {
+                    decode_image((const uint8_t*)request.body.data(), request.body.size(),
+                        swapper.acquire()->get_input_size(), image);
+                }
+                catch (const std::exception&) {
+                    image = DecodedImage();
+                }
+            }
+            std::future<ResultData> future;
+            if (image.empty()) {
+                sent = send_error(fd, 400, "the body is not a decodable image", keep_alive);
+            } else if (!batcher.submit(image, future)) {
+                sent = send_error(fd, 503, "the inference queue is full", keep_alive);
+            } else {
+                try {
+                    ResultData result = future.get();
+                    bool binary = request.query.find("format=binary") != std::string::npos ||
+                        request.headers["accept"].find("application/octet-stream") != std::string::npos;
+                    sent = binary ?
+                        send_response(fd, 200, "application/octet-stream", result_to_binary(result), keep_alive) :
+                        send_response(fd, 200, "application/json", result_to_json(result), keep_alive);
+                }
+                catch (const std::exception& e) {
+                    sent = send_error(fd, 500, json_escape(e.what()), keep_alive);
+                }
+            }
+        }
+        keep_alive = keep_alive && sent;
+    }
+    close(fd);
+}
+
+static int listen_on(const std::string& host, int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        throw std::runtime_error("socket failed.");
+    }
+    int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t)port);
+    if (inet_pton(AF_INET, host.c_str(), &addr.sin_addr) != 1 ||
+        bind(fd, (sockaddr*)&addr, sizeof(addr)) != 0 || listen(fd, 128) != 0) {
+        close(fd);
+        throw std::runtime_error("Cannot listen on " + host + ":" + std::to_string(port) + ".");
+    }
+    return fd;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 5) {
+        INFO("Please enter the correct parameters.");
+        INFO("For example:");
+        INFO("  rt-detr_http_server [model path] [lable path] [device] [post flag(1/0)] "
+            "[port(8080)] [max batch(4)] [max wait ms(2)] [io threads(8)] [host(127.0.0.1)] [cpu threads(0)] "
+            "[low memory(0/1)] [reload root]");
+        return 0;
+    }
+    bool post_flag;
+    std::istringstream(argv[4]) >> post_flag;
+    int port = argc > 5 ? std::atoi(argv[5]) : 8080;
+    BatcherConfig config;
+    config.max_batch = argc > 6 ? std::atoi(argv[6]) : 4;
+    config.max_wait_us = (int)((argc > 7 ? std::atof(argv[7]) : 2.0) * 1000);
+    config.max_queue = (size_t)std::max(config.max_batch, 1) * 16;
+    int io_threads = argc > 8 ? std::atoi(argv[8]) : 8;
+    std::string host = argc > 9 ? argv[9] : "127.0.0.1";
+    int cpu_threads = argc > 10 ? std::atoi(argv[10]) : 0;
+    bool low_memory = argc > 11 && std::atoi(argv[11]) != 0;
+    // POST /reload only loads bundles under this directory, and is disabled without it.
+    std::string reload_root;
+    if (argc > 12) {
+        reload_root = canonical_path(argv[12]);
+        if (reload_root.empty()) {
+            INFO(std::string("The reload root does not exist: ") + argv[12]);
+            return 1;
+        }
+    }
+
+    // One infer request per batch slot, so that a batch runs as one round of parallel requests. The
+    // low-memory mode keeps a single request, a batch then runs its images one after another.
+    PredictorOptions options = low_memory ? PredictorOptions::low_memory() : PredictorOptions();
+    options.num_requests = config.max_batch;
+    options.cpu_threads = cpu_threads;
+    ModelSwapper swapper(ModelBundle::from_paths(argv[1], argv[2], post_flag), argv[3], options);
+    DetectionBatcher batcher(swapper, config);
+    ThreadPool io_pool(io_threads, (size_t)io_threads * 4);
+    std::atomic<uint64_t> rejected_connections(0);
+
+    int listen_fd = listen_on(host, port);
+    std::signal(SIGINT, on_signal);
+    std::signal(SIGTERM, on_signal);
+    INFO("Listening on http://" + host + ":" + std::to_string(port) + "/detect");
+    while (!stop_flag) {
+        pollfd pfd = { listen_fd, POLLIN, 0 };
+        if (poll(&pfd, 1, 200) <= 0) {
+            continue;
+        }
+        int fd = accept(listen_fd, nullptr, nullptr);
+        if (fd < 0) {
+            continue;
+        }
+        // An idle keep-alive connection gives its I/O thread back after the timeout.
+        timeval timeout = { IDLE_TIMEOUT_SECONDS, 0 };
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        bool queued = io_pool.try_submit([fd, &batcher, &swapper, &io_pool, &reload_root, &rejected_connections] {
+            serve_connection(fd, batcher, swapper, io_pool, reload_root, rejected_connections);
+        });
+        if (!queued) {
+            // Backpressure: the connection is refused instead of queueing without bound.
+            ++rejected_connections;
+            send_error(fd, 503, "the server is busy", false);
+            close(fd);
+        }
+    }
+    close(listen_fd);
+    INFO("The server stopped.");
+    return 0;
+}
@@ -0,0 +1,219 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  16:20:47
+// @Brief  : This is common class.
+// @File    : image_decoder.cpp
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : 
+
+#include "image_decoder.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#ifdef RTDETR_WITH_LIBJPEG
+#include <csetjmp>
+#include <cstdio>
+#include <jpeglib.h>
+#endif
+
+
+/**
+ * The function returns a view of the decoded pixels that reports the detections in the size of the
+ * encoded image.
+ */
+ImageView DecodedImage::view() const {
+    ImageView image = ImageView::packed(pixels.data, pixels.cols, pixels.rows, pixels.step, format);
+    if (scale_denom > 1) {
+        image.source_width = full_width;
+        image.source_height = full_height;
+    }
+    return image;
+}
+
+/**
+ * The function reads the size of a JPEG from its frame header without decoding it.
+ *
+ * @return false if the data is not a JPEG.
+ */
+bool read_jpeg_size(const uint8_t* data, size_t size, int& width, int& height) {
+    if (size < 4 || data[0] != 0xFF || data[1] != 0xD8) {
+        return false;
+    }
+    size_t i = 2;
+    while (i + 4 <= size) {
+        if (data[i] != 0xFF) {
+            return false;
+        }
+        uint8_t marker = data[i + 1];
+        if (marker == 0xFF) {           // A fill byte.
+            ++i;
+            continue;
+        }
+        if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD8)) {
+            i += 2;
+            continue;
+        }
+        if (marker == 0xD9 || marker == 0xDA) {
+            return false;               // No frame header before the scan.
+        }
+        size_t length = (size_t)data[i + 2] << 8 | data[i + 3];
+        bool sof = marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC;
+        if (sof) {
+            if (i + 9 > size) {
+                return false;
+            }
+            height = data[i + 5] << 8 | data[i + 6];
+            width = data[i + 7] << 8 | data[i + 8];
+            return width > 0 && height > 0;
+        }
+        i += 2 + length;
+    }
+    return false;
+}
+
+/**
+ * The function `jpeg_scale_denom` picks the largest JPEG decoder downscale that keeps both sides of
+ * the decoded image at least as large as the model input, so the preprocess still only downsamples.
+ *
+ * @return 1, 2, 4 or 8.
+ */
+int jpeg_scale_denom(int width, int height, cv::Size target_size) {
+    for (int denom = 8; denom > 1; denom /= 2) {
+        if ((width + denom - 1) / denom >= target_size.width && (height + denom - 1) / denom >= target_size.height) {
+            return denom;
+        }
+    }
+    return 1;
+}
+
+#ifdef RTDETR_WITH_LIBJPEG
+
+namespace {
+
+struct JpegError {
+    jpeg_error_mgr mgr;
+    jmp_buf jump;
+    char message[JMSG_LENGTH_MAX];
+};
+
+void on_jpeg_error(j_common_ptr cinfo) {
+    JpegError* error = reinterpret_cast<JpegError*>(cinfo->err);
+    (*cinfo->err->format_message)(cinfo, error->message);
+    longjmp(error->jump, 1);
+}
+
+/**
+ * The function decodes a JPEG with libjpeg(-turbo) at 1/denom of its size, straight into the rows of
+ * `image.pixels`. It keeps no objects with destructors on its own frame, since an error longjmps out.
+ *
+ * @return false with the libjpeg message in `message` if the JPEG cannot be decoded, e.g. a CMYK JPEG.
+ */
+bool decode_libjpeg(const uint8_t* data, size_t size, int denom, DecodedImage& image, char* message) {
+    jpeg_decompress_struct cinfo;
+    JpegError error;
+    cinfo.err = jpeg_std_error(&error.mgr);
+    error.mgr.error_exit = on_jpeg_error;
+    if (setjmp(error.jump)) {
+        jpeg_destroy_decompress(&cinfo);
+        std::strcpy(message, error.message);
+        return false;
+    }
+    jpeg_create_decompress(&cinfo);
+    jpeg_mem_src(&cinfo, const_cast<unsigned char*>(data), (unsigned long)size);
+    jpeg_read_header(&cinfo, TRUE);
+    cinfo.scale_num = 1;
+    cinfo.scale_denom = denom;
+    const bool gray = cinfo.jpeg_color_space == JCS_GRAYSCALE;
+    cinfo.out_color_space = gray ? JCS_GRAYSCALE : JCS_RGB;
+    jpeg_start_decompress(&cinfo);
+    image.pixels.create((int)cinfo.output_height, (int)cinfo.output_width, gray ? CV_8UC1 : CV_8UC3);
+    image.format = gray ? PixelFormat::GRAY : PixelFormat::RGB;
+    image.full_width = (int)cinfo.image_width;
+    image.full_height = (int)cinfo.image_height;
+    image.scale_denom = denom;
+    JSAMPROW rows[8];
+    while (cinfo.output_scanline < cinfo.output_height) {
+        JDIMENSION count = std::min<JDIMENSION>(cinfo.rec_outbuf_height, 8);
+        count = std::min(count, cinfo.output_height - cinfo.output_scanline);
+        for (JDIMENSION r = 0; r < count; ++r) {
+            rows[r] = image.pixels.ptr<uint8_t>((int)(cinfo.output_scanline + r));
+        }
+        jpeg_read_scanlines(&cinfo, rows, count);
+    }
+    jpeg_finish_decompress(&cinfo);
+    jpeg_destroy_decompress(&cinfo);
+    return true;
+}
+
+} // namespace
+
+#endif
+
+/**
+ * The function `decode_image` decodes an encoded image near the model input size. A JPEG is decoded
+ * at the largest 1/2, 1/4 or 1/8 downscale that still covers `target_size` (see `jpeg_scale_denom`);
+ * the downscale happens inside the decoder, which skips most of the inverse DCT and color conversion
+ * work, and also avoids the aliasing of a large bilinear downsample. Other formats are decoded at full
+ * size by OpenCV. With libjpeg (RTDETR_WITH_LIBJPEG) the pixels are decoded as RGB, otherwise OpenCV's
+ * IMREAD_REDUCED_COLOR_* modes are used, which apply the same DCT scaling. Both paths ignore the EXIF
+ * orientation, so the pixels and the full size are those of the JPEG header.
+ *
+ * @param data, size The encoded image.
+ * @param target_size The model input size.
+ * @param image Receives the pixels; `image.view()` feeds `RTDETRPredictor::detect` and reports the
+ * detections in the size of the encoded image.
+ * @param scaled Whether to downscale JPEGs, false decodes them at full size.
+ */
+void decode_image(const uint8_t* data, size_t size, cv::Size target_size, DecodedImage& image, bool scaled) {
+    int width = 0, height = 0;
+    const bool jpeg = read_jpeg_size(data, size, width, height);
+    const int denom = jpeg && scaled ? jpeg_scale_denom(width, height, target_size) : 1;
+#ifdef RTDETR_WITH_LIBJPEG
+    char message[JMSG_LENGTH_MAX];
+    if (jpeg && decode_libjpeg(data, size, denom, image, message)) {
+        return;
+    }
+#endif
+    int flags = cv::IMREAD_COLOR;
+    switch (denom) {
+    case 2: flags = cv::IMREAD_REDUCED_COLOR_2; break;
+    case 4: flags = cv::IMREAD_REDUCED_COLOR_4; break;
+    case 8: flags = cv::IMREAD_REDUCED_COLOR_8; break;
+    default: break;
+    }
+    // libjpeg does not rotate either, and `full_width`/`full_height` come from the unrotated header.
+    flags |= cv::IMREAD_IGNORE_ORIENTATION;
+    cv::Mat encoded(1, (int)size, CV_8UC1, const_cast<uint8_t*>(data));
+    image.pixels = cv::imdecode(encoded, flags);
+    if (image.pixels.empty()) {
+        throw std::runtime_error("The image cannot be decoded.");
+    }
+    image.format = PixelFormat::BGR;
+    image.full_width = jpeg ? width : image.pixels.cols;
+    image.full_height = jpeg ? height : image.pixels.rows;
+    image.scale_denom = denom;
+}
+
+/**
+ * The function `decode_images` decodes a batch of encoded images in parallel on the OpenCV thread pool,
+ * one image per task. An image that cannot be decoded is left empty.
+ */
+void decode_images(const std::vector<std::vector<uint8_t>>& files, cv::Size target_size,
+    std::vector<DecodedImage>& images, bool scaled) {
+    images.assign(files.size(), DecodedImage());
+    cv::parallel_for_(cv::Range(0, (int)files.size()), [&](const cv::Range& range) {
+        for (int i = range.start; i < range.end; ++i) {
+            try {
+                decode_image(files[i].data(), files[i].size(), target_size, images[i], scaled);
+            }
+            catch (const std::exception&) {
+                images[i] = DecodedImage();
+            }
+        }
+    }, (double)files.size());
+}
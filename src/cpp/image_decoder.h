@@ -0,0 +1,46 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  16:12:30
+// @Brief  : This is common class.
+// @File    : image_decoder.h
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : Decoding of encoded images near the model input size. JPEGs are downscaled by 1/2,
+//                1/4 or 1/8 inside the decoder (in the DCT domain), so the full resolution pixels of a
+//                large photo are never produced.
+#ifndef __IMAGE_DECODER_H__
+#define __IMAGE_DECODER_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "opencv2/opencv.hpp"
+#include "image_input.h"
+
+// A decoded image, possibly downscaled from its encoded size.
+struct DecodedImage {
+    cv::Mat pixels;             // The decoded pixels, 8-bit with 1 or 3 channels.
+    PixelFormat format;         // RGB or GRAY when decoded by libjpeg, BGR when decoded by OpenCV.
+    int full_width;             // The size of the encoded image.
+    int full_height;
+    int scale_denom;            // The decoder downscale, 1, 2, 4 or 8.
+
+    DecodedImage() : format(PixelFormat::BGR), full_width(0), full_height(0), scale_denom(1) {}
+    bool empty() const { return pixels.empty(); }
+    ImageView view() const;
+};
+
+bool read_jpeg_size(const uint8_t* data, size_t size, int& width, int& height);
+
+int jpeg_scale_denom(int width, int height, cv::Size target_size);
+
+void decode_image(const uint8_t* data, size_t size, cv::Size target_size, DecodedImage& image,
+    bool scaled = true);
+
+void decode_images(const std::vector<std::vector<uint8_t>>& files, cv::Size target_size,
+    std::vector<DecodedImage>& images, bool scaled = true);
+
+#endif // !__IMAGE_DECODER_H__
@@ -0,0 +1,229 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  13:24:51
+// @Brief  : This is common class.
+// @File    : image_input.cpp
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : 
+
+#include "image_input.h"
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+
+ImageView ImageView::packed(const void* data, int width, int height, size_t stride, PixelFormat format) {
+    ImageView view;
+    view.planes[0] = static_cast<const uint8_t*>(data);
+    view.strides[0] = stride;
+    view.width = width;
+    view.height = height;
+    view.format = format;
+    return view;
+}
+
+ImageView ImageView::nv12(const void* y, size_t y_stride, const void* uv, size_t uv_stride,
+    int width, int height, PixelFormat format) {
+    ImageView view = packed(y, width, height, y_stride, format);
+    view.planes[1] = static_cast<const uint8_t*>(uv);
+    view.strides[1] = uv_stride;
+    return view;
+}
+
+ImageView ImageView::i420(const void* y, size_t y_stride, const void* u, size_t u_stride,
+    const void* v, size_t v_stride, int width, int height) {
+    ImageView view = packed(y, width, height, y_stride, PixelFormat::I420);
+    view.planes[1] = static_cast<const uint8_t*>(u);
+    view.strides[1] = u_stride;
+    view.planes[2] = static_cast<const uint8_t*>(v);
+    view.strides[2] = v_stride;
+    return view;
+}
+
+/**
+ * The function `from_mat` wraps an 8-bit cv::Mat without copying it. A 1 or 4 channel image is taken
+ * as GRAY or BGRA whatever `format` says.
+ *
+ * @param image The image, it must outlive the view.
+ * @param format The channel order of a 3 channel image, BGR (the OpenCV default) or RGB.
+ */
+ImageView ImageView::from_mat(const cv::Mat& image, PixelFormat format) {
+    if (image.depth() != CV_8U) {
+        throw std::invalid_argument("Only 8-bit images are supported.");
+    }
+    if (image.channels() == 1) {
+        format = PixelFormat::GRAY;
+    } else if (image.channels() == 4) {
+        format = format == PixelFormat::RGB ? PixelFormat::RGBA : PixelFormat::BGRA;
+    }
+    return packed(image.data, image.cols, image.rows, image.step, format);
+}
+
+
+namespace {
+
+// The two source taps of a bilinear sample and the weight of the second one.
+struct Tap {
+    int i0, i1;
+    float w;
+};
+
+/**
+ * The function builds the taps of a bilinear resize from `src` to `dst` samples, with the pixel center
+ * mapping of cv::resize INTER_LINEAR. `ratio` is 2 for the half resolution chroma planes, whose
+ * samples sit between two luma samples.
+ */
+void make_taps(int src, int dst, int luma, int ratio, std::vector<Tap>& taps) {
+    taps.resize(dst);
+    const float scale = (float)luma / dst / ratio;
+    for (int d = 0; d < dst; ++d) {
+        float s = std::max((d + 0.5f) * scale - 0.5f, 0.0f);
+        int i0 = std::min((int)s, src - 1);
+        taps[d].i0 = i0;
+        taps[d].i1 = std::min(i0 + 1, src - 1);
+        taps[d].w = i0 < src - 1 ? s - i0 : 0.0f;
+    }
+}
+
+/**
+ * The function samples one output row of a packed image into the planar RGB blob.
+ *
+ * @tparam CN The number of channels of a pixel.
+ * @tparam R, G, B The byte offsets of the channels in a pixel.
+ */
+template<int CN, int R, int G, int B>
+void sample_packed_row(const uint8_t* row0, const uint8_t* row1, float wy, const std::vector<Tap>& taps,
+    float* dst_r, float* dst_g, float* dst_b) {
+    const float k = 1.0f / 255.0f;
+    for (size_t x = 0; x < taps.size(); ++x) {
+        const Tap& t = taps[x];
+        const uint8_t* p00 = row0 + t.i0 * CN;
+        const uint8_t* p01 = row0 + t.i1 * CN;
+        const uint8_t* p10 = row1 + t.i0 * CN;
+        const uint8_t* p11 = row1 + t.i1 * CN;
+        float w00 = (1.0f - t.w) * (1.0f - wy) * k, w01 = t.w * (1.0f - wy) * k;
+        float w10 = (1.0f - t.w) * wy * k, w11 = t.w * wy * k;
+        dst_r[x] = p00[R] * w00 + p01[R] * w01 + p10[R] * w10 + p11[R] * w11;
+        dst_g[x] = p00[G] * w00 + p01[G] * w01 + p10[G] * w10 + p11[G] * w11;
+        dst_b[x] = p00[B] * w00 + p01[B] * w01 + p10[B] * w10 + p11[B] * w11;
+    }
+}
+
+inline float bilinear(const uint8_t* row0, const uint8_t* row1, int i0, int i1, int step, float wx, float wy) {
+    float top = row0[i0 * step] + (row0[i1 * step] - row0[i0 * step]) * wx;
+    float bottom = row1[i0 * step] + (row1[i1 * step] - row1[i0 * step]) * wx;
+    return top + (bottom - top) * wy;
+}
+
+inline float clamp01(float v) {
+    return std::min(std::max(v, 0.0f), 1.0f);
+}
+
+/**
+ * The function samples one output row of a YUV 4:2:0 image into the planar RGB blob. Luma and chroma
+ * are interpolated on their own planes, then converted with the BT.601 limited range matrix that
+ * cv::COLOR_YUV2RGB_NV12 uses. Since the conversion is linear, this equals converting first.
+ *
+ * @param u_row0, u_row1, v_row0, v_row1 The chroma rows around the sample, each starting at its
+ * first U or V byte.
+ * @param cstep The byte distance between two chroma samples, 2 for NV12/NV21 and 1 for I420.
+ */
+void sample_yuv_row(const uint8_t* y_row0, const uint8_t* y_row1, float wy, const std::vector<Tap>& taps,
+    const uint8_t* u_row0, const uint8_t* u_row1, const uint8_t* v_row0, const uint8_t* v_row1, int cstep,
+    float cwy, const std::vector<Tap>& ctaps, float* dst_r, float* dst_g, float* dst_b) {
+    const float k = 1.0f / 255.0f;
+    for (size_t x = 0; x < taps.size(); ++x) {
+        const Tap& t = taps[x];
+        const Tap& c = ctaps[x];
+        float y = (bilinear(y_row0, y_row1, t.i0, t.i1, 1, t.w, wy) - 16.0f) * 1.164f;
+        float u = bilinear(u_row0, u_row1, c.i0, c.i1, cstep, c.w, cwy) - 128.0f;
+        float v = bilinear(v_row0, v_row1, c.i0, c.i1, cstep, c.w, cwy) - 128.0f;
+        dst_r[x] = clamp01((y + 1.596f * v) * k);
+        dst_g[x] = clamp01((y - 0.813f * v - 0.391f * u) * k);
+        dst_b[x] = clamp01((y + 2.018f * u) * k);
+    }
+}
+
+} // namespace
+
+
+/**
+ * The function `blob_from_image` converts an image buffer into the model input in one pass: every
+ * output pixel is resized (bilinear), color converted to RGB and normalized to [0, 1], and written to
+ * the planar [3, H, W] float blob. No intermediate BGR or float image is materialized. The rows are
+ * processed in parallel by the OpenCV thread pool.
+ *
+ * @param image The view of the source image.
+ * @param target_size The model input size.
+ * @param blob The output buffer of 3 * target_size.area() floats, usually the input tensor data.
+ */
+void blob_from_image(const ImageView& image, cv::Size target_size, float* blob) {
+    if (image.empty()) {
+        throw std::invalid_argument("The input image is empty.");
+    }
+    const int dst_w = target_size.width;
+    const int dst_h = target_size.height;
+    const size_t area = (size_t)dst_w * dst_h;
+    const bool yuv = image.format == PixelFormat::NV12 || image.format == PixelFormat::NV21 ||
+        image.format == PixelFormat::I420;
+    if (yuv && image.planes[1] == nullptr) {
+        throw std::invalid_argument("The chroma plane of the YUV image is missing.");
+    }
+    if (image.format == PixelFormat::I420 && image.planes[2] == nullptr) {
+        throw std::invalid_argument("The V plane of the I420 image is missing.");
+    }
+    std::vector<Tap> xtaps, ytaps, cxtaps, cytaps;
+    make_taps(image.width, dst_w, image.width, 1, xtaps);
+    make_taps(image.height, dst_h, image.height, 1, ytaps);
+    if (yuv) {
+        make_taps((image.width + 1) / 2, dst_w, image.width, 2, cxtaps);
+        make_taps((image.height + 1) / 2, dst_h, image.height, 2, cytaps);
+    }
+
+    cv::parallel_for_(cv::Range(0, dst_h), [&](const cv::Range& range) {
+        for (int y = range.start; y < range.end; ++y) {
+            const Tap& ty = ytaps[y];
+            const uint8_t* row0 = image.planes[0] + ty.i0 * image.strides[0];
+            const uint8_t* row1 = image.planes[0] + ty.i1 * image.strides[0];
+            float* r = blob + (size_t)y * dst_w;
+            float* g = r + area;
+            float* b = g + area;
+            switch (image.format) {
+            case PixelFormat::BGR: sample_packed_row<3, 2, 1, 0>(row0, row1, ty.w, xtaps, r, g, b); break;
+            case PixelFormat::RGB: sample_packed_row<3, 0, 1, 2>(row0, row1, ty.w, xtaps, r, g, b); break;
+            case PixelFormat::BGRA: sample_packed_row<4, 2, 1, 0>(row0, row1, ty.w, xtaps, r, g, b); break;
+            case PixelFormat::RGBA: sample_packed_row<4, 0, 1, 2>(row0, row1, ty.w, xtaps, r, g, b); break;
+            case PixelFormat::GRAY: sample_packed_row<1, 0, 0, 0>(row0, row1, ty.w, xtaps, r, g, b); break;
+            default: {
+                const Tap& cy = cytaps[y];
+                const uint8_t* u0;
+                const uint8_t* u1;
+                const uint8_t* v0;
+                const uint8_t* v1;
+                int cstep;
+                if (image.format == PixelFormat::I420) {
+                    u0 = image.planes[1] + cy.i0 * image.strides[1];
+                    u1 = image.planes[1] + cy.i1 * image.strides[1];
+                    v0 = image.planes[2] + cy.i0 * image.strides[2];
+                    v1 = image.planes[2] + cy.i1 * image.strides[2];
+                    cstep = 1;
+                } else {
+                    int u_off = image.format == PixelFormat::NV12 ? 0 : 1;
+                    const uint8_t* c0 = image.planes[1] + cy.i0 * image.strides[1];
+                    const uint8_t* c1 = image.planes[1] + cy.i1 * image.strides[1];
+                    u0 = c0 + u_off;
+                    u1 = c1 + u_off;
+                    v0 = c0 + 1 - u_off;
+                    v1 = c1 + 1 - u_off;
+                    cstep = 2;
+                }
+                sample_yuv_row(row0, row1, ty.w, xtaps, u0, u1, v0, v1, cstep, cy.w, cxtaps, r, g, b);
+                break;
+            }
+            }
+        }
+    });
+}
@@ -0,0 +1,44 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  13:21:08
+// @Brief  : This is common class.
+// @File    : image_input.h
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : 
+#ifndef __IMAGE_INPUT_H__
+#define __IMAGE_INPUT_H__
+
+#include <cstddef>
+#include <cstdint>
+
+#include "opencv2/opencv.hpp"
+#include "pixel_format.h"
+
+
+// A non-owning view of an image buffer. The buffer must stay valid while the view is in use.
+struct ImageView {
+    const uint8_t* planes[3];   // The Y or packed plane, then the chroma planes of the YUV formats.
+    size_t strides[3];          // The bytes per row of each plane.
+    int width;
+    int height;
+    PixelFormat format;
+    int source_width;           // The size of the image the view was downscaled from (e.g. by a
+    int source_height;          // DCT-scaled JPEG decode), the detections are reported in it. 0 if none.
+
+    ImageView() : planes(), strides(), width(0), height(0), format(PixelFormat::BGR),
+        source_width(0), source_height(0) {}
+    static ImageView packed(const void* data, int width, int height, size_t stride, PixelFormat format);
+    static ImageView nv12(const void* y, size_t y_stride, const void* uv, size_t uv_stride,
+        int width, int height, PixelFormat format = PixelFormat::NV12);
+    static ImageView i420(const void* y, size_t y_stride, const void* u, size_t u_stride,
+        const void* v, size_t v_stride, int width, int height);
+    static ImageView from_mat(const cv::Mat& image, PixelFormat format = PixelFormat::BGR);
+    bool empty() const { return planes[0] == nullptr || width <= 0 || height <= 0; }
+};
+
+void blob_from_image(const ImageView& image, cv::Size target_size, float* blob);
+
+#endif // !__IMAGE_INPUT_H__
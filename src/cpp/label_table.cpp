@@ -0,0 +1,71 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  20:11:52
+// @Brief  : This is common class.
+// @File    : label_table.cpp
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : 
+
+#include "label_table.h"
+#include <cstring>
+#include <stdexcept>
+
+#include "mapped_file.h"
+
+
+/**
+ * The function `parse` splits a label text into lines. Both LF and CRLF line breaks are accepted, a
+ * UTF-8 byte order mark and the line break at the end of the text are ignored. Empty lines in between
+ * are kept, so that the line number stays the class id.
+ *
+ * @param text The label text, it does not have to be null-terminated.
+ * @param size The bytes of the text.
+ */
+LabelTable LabelTable::parse(const char* text, size_t size) {
+    LabelTable table;
+    if (size >= 3 && std::memcmp(text, "\xEF\xBB\xBF", 3) == 0) {
+        text += 3;
+        size -= 3;
+    }
+    table.arena.reserve(size);
+    table.offsets.push_back(0);
+    const char* end = text + size;
+    while (text < end) {
+        const char* line_end = (const char*)std::memchr(text, '\n', end - text);
+        const char* next = line_end ? line_end + 1 : end;
+        line_end = line_end ? line_end : end;
+        if (line_end > text && line_end[-1] == '\r') {
+            --line_end;
+        }
+        table.arena.insert(table.arena.end(), text, line_end);
+        table.offsets.push_back((uint32_t)table.arena.size());
+        text = next;
+    }
+    return table;
+}
+
+/**
+ * The function `load` reads a label file through a memory mapping, so that the labels are copied once,
+ * straight into the arena.
+ *
+ * @param path The path of the label file.
+ *
+ * A std::runtime_error is thrown if the file cannot be read.
+ */
+LabelTable LabelTable::load(const std::string& path) {
+    MappedFile file(path);
+    return parse((const char*)file.get_data(), file.get_size());
+}
+
+/**
+ * The function returns the label of a class, or the class id as text if the table has no such label.
+ */
+std::string LabelTable::get(int clsid) const {
+    if (clsid >= 0 && clsid < size()) {
+        return std::string(arena.data() + offsets[clsid], arena.data() + offsets[clsid + 1]);
+    }
+    return std::to_string(clsid);
+}
@@ -0,0 +1,36 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  20:04:17
+// @Brief  : This is common class.
+// @File    : label_table.h
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : The class names of a model, one per line of the label file, stored back to back in
+//                a single arena.
+#ifndef __LABEL_TABLE_H__
+#define __LABEL_TABLE_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class LabelTable
+{
+public:
+    LabelTable() {}
+    static LabelTable parse(const char* text, size_t size);
+    static LabelTable load(const std::string& path);
+    int size() const { return offsets.empty() ? 0 : (int)offsets.size() - 1; }
+    bool empty() const { return size() == 0; }
+    std::string get(int clsid) const;
+    size_t get_bytes() const { return arena.capacity() + offsets.capacity() * sizeof(uint32_t); }
+
+private:
+    std::vector<char> arena;            // The labels without line breaks, back to back.
+    std::vector<uint32_t> offsets;      // The start of every label in `arena`, followed by its end.
+};
+
+#endif // !__LABEL_TABLE_H__
@@ -0,0 +1,115 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  19:55:41
+// @Brief  : This is common class.
+// @File    : mapped_file.cpp
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : 
+
+#include "mapped_file.h"
+#include <stdexcept>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+/**
+ * The function `open` maps a whole file read-only. The pages are loaded on first access and shared
+ * with the page cache, so mapping a large file costs no copy. An empty file gives an empty mapping.
+ *
+ * @param path The path of the file.
+ *
+ * A std::runtime_error is thrown if the file cannot be opened or mapped.
+ */
+void MappedFile::open(const std::string& path) {
+    close();
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Cannot open " + path + ".");
+    }
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size)) {
+        CloseHandle(file);
+        throw std::runtime_error("Cannot read the size of " + path + ".");
+    }
+    size = (size_t)file_size.QuadPart;
+    if (size > 0) {
+        handle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        data = handle ? (const uint8_t*)MapViewOfFile(handle, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    }
+    CloseHandle(file);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open " + path + ".");
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot read the size of " + path + ".");
+    }
+    size = (size_t)st.st_size;
+    if (size > 0) {
+        void* base = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        data = base == MAP_FAILED ? nullptr : (const uint8_t*)base;
+    }
+    ::close(fd);
+#endif
+    if (size > 0 && data == nullptr) {
+        close();
+        throw std::runtime_error("Cannot map " + path + ".");
+    }
+}
+
+/**
+ * The function `close` unmaps the file, the data pointer becomes invalid.
+ */
+void MappedFile::close() {
+#if defined(_WIN32)
+    if (data != nullptr) {
+        UnmapViewOfFile(data);
+    }
+    if (handle != nullptr) {
+        CloseHandle(handle);
+    }
+#else
+    if (data != nullptr) {
+        munmap((void*)data, size);
+    }
+#endif
+    data = nullptr;
+    size = 0;
+    handle = nullptr;
+}
+
+/**
+ * The function `prefault` reads one byte of every page, so that the file is in the page cache and the
+ * pages of this and every other mapping of it (e.g. the weights mapped by OpenVINO) are resident
+ * before they are needed.
+ *
+ * @return the bytes paged in.
+ */
+size_t MappedFile::prefault() const {
+#if !defined(_WIN32)
+    if (data != nullptr) {
+        madvise((void*)data, size, MADV_WILLNEED);
+    }
+#endif
+    const size_t page = 4096;
+    volatile uint8_t sink = 0;
+    for (size_t i = 0; i < size; i += page) {
+        sink = sink ^ data[i];
+    }
+    return size;
+}
@@ -0,0 +1,41 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  19:48:06
+// @Brief  : This is common class.
+// @File    : mapped_file.h
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : A read-only memory mapping of a whole file.
+#ifndef __MAPPED_FILE_H__
+#define __MAPPED_FILE_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class MappedFile
+{
+public:
+    MappedFile() : data(nullptr), size(0), handle(nullptr) {}
+    explicit MappedFile(const std::string& path) : data(nullptr), size(0), handle(nullptr) { open(path); }
+    ~MappedFile() { close(); }
+    void open(const std::string& path);
+    void close();
+    const uint8_t* get_data() const { return data; }
+    size_t get_size() const { return size; }
+    bool empty() const { return size == 0; }
+    size_t prefault() const;
+
+private:
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+
+private:
+    const uint8_t* data;
+    size_t size;
+    void* handle;               // The file mapping object on Windows.
+};
+
+#endif // !__MAPPED_FILE_H__
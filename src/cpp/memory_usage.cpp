@@ -0,0 +1,112 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  22:15:02
+// @Brief  : This is common class.
+// @File    : memory_usage.cpp
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : 
+
+#include "memory_usage.h"
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <unistd.h>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+#endif
+
+
+/**
+ * The function `current_rss` returns the resident set size of the process: the resident pages of
+ * /proc/self/statm on Linux, the working set on Windows.
+ *
+ * @return the bytes, 0 if the platform does not report it.
+ */
+uint64_t current_rss() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return (uint64_t)counters.WorkingSetSize;
+    }
+    return 0;
+#else
+    FILE* file = std::fopen("/proc/self/statm", "r");
+    if (file == nullptr) {
+        return 0;
+    }
+    unsigned long long size = 0, resident = 0;
+    int fields = std::fscanf(file, "%llu %llu", &size, &resident);
+    std::fclose(file);
+    return fields == 2 ? (uint64_t)resident * (uint64_t)sysconf(_SC_PAGESIZE) : 0;
+#endif
+}
+
+/**
+ * The function `peak_rss` returns the highest resident set size of the process so far: VmHWM of
+ * /proc/self/status on Linux, the peak working set on Windows.
+ *
+ * @return the bytes, 0 if the platform does not report it.
+ */
+uint64_t peak_rss() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return (uint64_t)counters.PeakWorkingSetSize;
+    }
+    return 0;
+#else
+    FILE* file = std::fopen("/proc/self/status", "r");
+    if (file == nullptr) {
+        return 0;
+    }
+    char line[256];
+    unsigned long long kb = 0;
+    while (std::fgets(line, sizeof(line), file) != nullptr) {
+        if (std::strncmp(line, "VmHWM:", 6) == 0) {
+            std::sscanf(line + 6, "%llu", &kb);
+            break;
+        }
+    }
+    std::fclose(file);
+    return (uint64_t)kb * 1024;
+#endif
+}
+
+/**
+ * The function `trim_heap` hands the free memory at the top of the heap and in the malloc arenas back
+ * to the system, glibc keeps it otherwise. Freed model graphs only show as a lower RSS after this.
+ */
+void trim_heap() {
+#if defined(__GLIBC__)
+    malloc_trim(0);
+#endif
+}
+
+/**
+ * The function `model_weight_bytes` adds up the data of the Constant nodes of a model, i.e. its
+ * weights as held by the `ov::Model`.
+ */
+uint64_t model_weight_bytes(const std::shared_ptr<ov::Model>& model) {
+    uint64_t bytes = 0;
+    for (const std::shared_ptr<ov::Node>& node : model->get_ops()) {
+        if (std::string(node->get_type_name()) != "Constant") {
+            continue;
+        }
+        const ov::Output<ov::Node> output = node->output(0);
+        if (output.get_partial_shape().is_static()) {
+            // Bit widths rather than byte sizes, so that packed low-bit weights are not overcounted.
+            bytes += ((uint64_t)ov::shape_size(output.get_shape()) * output.get_element_type().bitwidth() + 7) / 8;
+        }
+    }
+    return bytes;
+}
@@ -0,0 +1,28 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  22:14:36
+// @Brief  : This is common class.
+// @File    : memory_usage.h
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : The resident memory of the process and the weight size of a model, for the memory
+//                accounting of the predictor.
+#ifndef __MEMORY_USAGE_H__
+#define __MEMORY_USAGE_H__
+
+#include <cstdint>
+#include <memory>
+
+#include "openvino/openvino.hpp"
+
+uint64_t current_rss();
+
+uint64_t peak_rss();
+
+void trim_heap();
+
+uint64_t model_weight_bytes(const std::shared_ptr<ov::Model>& model);
+
+#endif // !__MEMORY_USAGE_H__
@@ -0,0 +1,191 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  20:38:09
+// @Brief  : This is common class.
+// @File    : model_bundle.cpp
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : 
+
+#include "model_bundle.h"
+#include <stdexcept>
+#include <vector>
+
+
+/**
+ * The function resolves a path of the manifest against the bundle directory, absolute paths are kept.
+ */
+static std::string bundle_path(const std::string& dir, const std::string& path) {
+    bool absolute = !path.empty() && (path[0] == '/' || path[0] == '\\' || (path.size() > 1 && path[1] == ':'));
+    return absolute || path.empty() ? path : dir + "/" + path;
+}
+
+/**
+ * The function reads a [width, height] pair, an absent node gives an empty size.
+ */
+static cv::Size read_size(const cv::FileNode& node, const std::string& key) {
+    if (node.empty()) {
+        return cv::Size();
+    }
+    if (!node.isSeq() || node.size() != 2 || (int)node[0] <= 0 || (int)node[1] <= 0) {
+        throw std::runtime_error("The bundle key \"" + key + "\" must be [width, height].");
+    }
+    return cv::Size((int)node[0], (int)node[1]);
+}
+
+/**
+ * The function checks the interpolation of the manifest. The fused preprocess of the predictor scales
+ * bilinearly, so no other method can be honoured.
+ */
+static void check_interpolation(const std::string& name) {
+    if (!name.empty() && name != "linear") {
+        throw std::runtime_error("Unsupported interpolation \"" + name + "\" in the bundle, only \"linear\" is.");
+    }
+}
+
+static NmsMethod read_nms_method(const std::string& name) {
+    if (name.empty() || name == "none") return NmsMethod::NONE;
+    if (name == "hard") return NmsMethod::HARD;
+    if (name == "soft_linear") return NmsMethod::SOFT_LINEAR;
+    if (name == "soft_gaussian") return NmsMethod::SOFT_GAUSSIAN;
+    if (name == "weighted") return NmsMethod::WEIGHTED;
+    throw std::runtime_error("Unknown NMS method \"" + name + "\" in the bundle.");
+}
+
+/**
+ * The function `from_paths` describes a model given by its paths alone, the rest is resolved from the
+ * model at load time.
+ */
+ModelBundle ModelBundle::from_paths(const std::string& model_path, const std::string& label_path, bool post_flag) {
+    ModelBundle bundle;
+    bundle.model_path = model_path;
+    bundle.label_path = label_path;
+    bundle.post_flag = post_flag;
+    return bundle;
+}
+
+/**
+ * The function `load_bundle` reads a bundle manifest, see model_bundle.h for its keys.
+ *
+ * @param path The bundle directory holding `bundle.json`, or the path of a manifest.
+ *
+ * @return the ModelBundle object with its paths resolved against the bundle directory. A
+ * std::runtime_error is thrown if the manifest cannot be read or has an invalid value.
+ */
+ModelBundle load_bundle(const std::string& path) {
+    bool manifest_flag = path.size() > 5 && path.compare(path.size() - 5, 5, ".json") == 0;
+    std::string manifest = manifest_flag ? path : path + "/bundle.json";
+    size_t slash = manifest.find_last_of("/\\");
+    std::string dir = slash == std::string::npos ? "." : manifest.substr(0, slash);
+
+    cv::FileStorage fs(manifest, cv::FileStorage::READ | cv::FileStorage::FORMAT_JSON);
+    if (!fs.isOpened()) {
+        throw std::runtime_error("Cannot open the bundle manifest " + manifest + ".");
+    }
+    ModelBundle bundle;
+    bundle.model_path = bundle_path(dir, (std::string)fs["model"]);
+    if (bundle.model_path.empty()) {
+        throw std::runtime_error("The bundle manifest " + manifest + " has no \"model\".");
+    }
+    bundle.label_path = bundle_path(dir, (std::string)fs["labels"]);
+    if (!fs["post_processed"].empty()) {
+        bundle.post_flag = (int)fs["post_processed"] != 0;
+    }
+    if (!fs["num_classes"].empty()) {
+        bundle.num_classes = (int)fs["num_classes"];
+    }
+    bundle.input_size = read_size(fs["input_size"], "input_size");
+    bundle.max_input_size = read_size(fs["max_input_size"], "max_input_size");
+    check_interpolation((std::string)fs["interpolation"]);
+
+    cv::FileNode inputs = fs["inputs"];
+    bundle.image_input = (std::string)inputs["image"];
+    bundle.shape_input = (std::string)inputs["im_shape"];
+    bundle.scale_input = (std::string)inputs["scale_factor"];
+    cv::FileNode outputs = fs["outputs"];
+    bundle.result_output = (std::string)outputs["result"];
+    bundle.result_num_output = (std::string)outputs["result_num"];
+    bundle.score_output = (std::string)outputs["scores"];
+    bundle.bbox_output = (std::string)outputs["boxes"];
+
+    if (!fs["threshold"].empty()) {
+        bundle.filter.threshold = (float)fs["threshold"];
+    }
+    fs["class_thresholds"] >> bundle.filter.class_thresholds;
+    fs["allowed_classes"] >> bundle.filter.allowed_classes;
+    if (!fs["max_detections"].empty()) {
+        bundle.filter.max_detections = (int)fs["max_detections"];
+    }
+    cv::FileNode nms = fs["nms"];
+    if (!nms.empty()) {
+        bundle.nms.method = read_nms_method((std::string)nms["method"]);
+        if (!nms["iou_threshold"].empty()) bundle.nms.iou_threshold = (float)nms["iou_threshold"];
+        if (!nms["sigma"].empty()) bundle.nms.sigma = (float)nms["sigma"];
+        if (!nms["score_threshold"].empty()) bundle.nms.score_threshold = (float)nms["score_threshold"];
+        if (!nms["class_aware"].empty()) bundle.nms.class_aware = (int)nms["class_aware"] != 0;
+        // The NMS limit is the top-level one, see `RTDETRProcess::set_nms`.
+        if (!nms["max_detections"].empty() && (int)nms["max_detections"] != bundle.filter.max_detections) {
+            throw std::runtime_error("The bundle key \"nms.max_detections\" differs from \"max_detections\".");
+        }
+    }
+    return bundle;
+}
+
+/**
+ * The function returns the index of the model output with the given name.
+ */
+static int output_index(std::shared_ptr<ov::Model> model, const std::string& name) {
+    std::vector<ov::Output<ov::Node>> outputs = model->outputs();
+    for (int i = 0; i < (int)outputs.size(); ++i) {
+        if (outputs[i].get_any_name() == name) {
+            return i;
+        }
+    }
+    throw std::runtime_error("The model has no output \"" + name + "\".");
+}
+
+/**
+ * The function checks that an input name of the bundle exists in the model.
+ */
+static void check_input(std::shared_ptr<ov::Model> model, const std::string& name) {
+    for (auto input : model->inputs()) {
+        if (input.get_any_name() == name) {
+            return;
+        }
+    }
+    throw std::runtime_error("The model has no input \"" + name + "\".");
+}
+
+/**
+ * The function `read_bundle_model_info` resolves the input and output roles of the bundle model. The
+ * names given by the bundle are applied first, and only the roles it leaves out are resolved from the
+ * model shapes by `read_model_info`; the input size of the bundle replaces the one of the model.
+ *
+ * @param model The model of the bundle.
+ * @param bundle The ModelBundle object.
+ *
+ * @return the ModelInfo object. A std::runtime_error is thrown if a name does not exist in the model,
+ * or if a role left out cannot be resolved.
+ */
+ModelInfo read_bundle_model_info(std::shared_ptr<ov::Model> model, const ModelBundle& bundle) {
+    ModelInfo known;
+    const std::string* inputs[] = { &bundle.image_input, &bundle.shape_input, &bundle.scale_input };
+    std::string* roles[] = { &known.image_input, &known.shape_input, &known.scale_input };
+    for (int i = 0; i < 3; ++i) {
+        if (!inputs[i]->empty()) {
+            check_input(model, *inputs[i]);
+            *roles[i] = *inputs[i];
+        }
+    }
+    if (!bundle.result_output.empty()) known.result_index = output_index(model, bundle.result_output);
+    if (!bundle.result_num_output.empty()) known.result_num_index = output_index(model, bundle.result_num_output);
+    if (!bundle.score_output.empty()) known.score_index = output_index(model, bundle.score_output);
+    if (!bundle.bbox_output.empty()) known.bbox_index = output_index(model, bundle.bbox_output);
+    ModelInfo info = read_model_info(model, bundle.post_flag, known);
+    if (bundle.input_size.area() > 0) {
+        info.input_size = bundle.input_size;
+    }
+    return info;
+}
@@ -0,0 +1,68 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  20:26:35
+// @Brief  : This is common class.
+// @File    : model_bundle.h
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : A model bundle: a directory with a `bundle.json` manifest describing the model, its
+//                labels and its pre- and post-processing, so that one path deploys one model.
+//
+//                {
+//                    "model": "rtdetr_r50vd_6x_coco.xml",      IR or ONNX, relative to the manifest
+//                    "labels": "COCO_lable.txt",
+//                    "post_processed": 1,
+//                    "num_classes": 80,                        checked against the labels
+//                    "input_size": [640, 640],                 or "max_input_size" for a dynamic input
+//                    "interpolation": "linear",                the fused preprocess is bilinear only
+//                    "inputs": { "image": "image", "im_shape": "im_shape", "scale_factor": "scale_factor" },
+//                    "outputs": { "result": "...", "result_num": "...", "scores": "...", "boxes": "..." },
+//                    "threshold": 0.5,
+//                    "class_thresholds": [ ... ],
+//                    "allowed_classes": [ ... ],
+//                    "max_detections": 100,
+//                    "nms": { "method": "hard", "iou_threshold": 0.5, "class_aware": 1 }
+//                }
+//
+//                The NMS stage keeps at most the top-level "max_detections" boxes, an "nms" limit must
+//                not differ from it. Only "model" is required. Input and output names left out are
+//                resolved from the model shapes, see `read_model_info`.
+#ifndef __MODEL_BUNDLE_H__
+#define __MODEL_BUNDLE_H__
+
+#include <memory>
+#include <string>
+
+#include "openvino/openvino.hpp"
+#include "opencv2/opencv.hpp"
+#include "model_info.h"
+#include "nms.h"
+#include "process.h"
+
+struct ModelBundle {
+    std::string model_path;         // The IR (.xml) or ONNX model.
+    std::string label_path;         // The label file, empty for none.
+    bool post_flag;                 // Whether the model includes the post-processing layers.
+    int num_classes;                // The expected class count, -1 to take it from the model.
+    cv::Size input_size;            // The static image input size, empty to take it from the model.
+    cv::Size max_input_size;        // The bound of a dynamic image input, empty for a static input.
+    std::string image_input;        // The input and output names, empty to resolve them from the shapes.
+    std::string shape_input;
+    std::string scale_input;
+    std::string result_output;
+    std::string result_num_output;
+    std::string score_output;
+    std::string bbox_output;
+    FilterConfig filter;
+    NmsConfig nms;
+    ModelBundle() : post_flag(true), num_classes(-1) {}
+    static ModelBundle from_paths(const std::string& model_path, const std::string& label_path, bool post_flag);
+};
+
+ModelBundle load_bundle(const std::string& path);
+
+ModelInfo read_bundle_model_info(std::shared_ptr<ov::Model> model, const ModelBundle& bundle);
+
+#endif // !__MODEL_BUNDLE_H__
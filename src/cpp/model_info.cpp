@@ -0,0 +1,232 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  09:14:02
+// @Brief  : This is common class.
+// @File    : model_info.cpp
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : 
+
+#include "model_info.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+
+/**
+ * The function returns the static length of a dimension, or -1 if the dimension is dynamic.
+ */
+static int static_length(const ov::Dimension& dim) {
+    return dim.is_static() ? (int)dim.get_length() : -1;
+}
+
+/**
+ * The function checks whether the name of a model port contains the given key, ignoring case.
+ */
+static bool name_contains(const ov::Output<ov::Node>& port, std::string key) {
+    std::string name = port.get_any_name();
+    std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+    return name.find(key) != std::string::npos;
+}
+
+/**
+ * The function `read_model_info` resolves the roles and dimensions of the model inputs and outputs
+ * from their shapes, so that no tensor name, output order or class count has to be hard-coded.
+ *
+ * The image input is the only rank 4 input; the remaining rank 2 inputs of a post-processed model are
+ * told apart by name, falling back to the Paddle export order (im_shape before scale_factor). The
+ * result of a post-processed model is the [M,6] output, optionally paired with a rank 1 count output.
+ * The raw head model has a [N,Q,4] box output and a [N,Q,C] logits output; if C is also 4, the output
+ * names decide, falling back to the Paddle export order (boxes first).
+ *
+ * @param model A shared pointer to an instance of the `ov::Model` class.
+ * @param post_flag Whether the model includes the post-processing layers.
+ * @param known The roles already known, e.g. named by a model bundle (see `read_bundle_model_info`).
+ * They are kept as they are and left out of the inference, so that a model whose shapes alone are
+ * ambiguous, e.g. with an extra rank 3 output, loads once its bundle names the outputs.
+ *
+ * @return a ModelInfo object describing the model. A std::runtime_error is thrown if the model does
+ * not match the expected layout.
+ */
+ModelInfo read_model_info(std::shared_ptr<ov::Model> model, bool post_flag, const ModelInfo& known) {
+    ModelInfo info = known;
+    info.post_flag = post_flag;
+
+    std::vector<ov::Output<ov::Node>> inputs = model->inputs();
+    std::vector<ov::Output<ov::Node>> extra_inputs;
+    for (auto input : inputs) {
+        std::string name = input.get_any_name();
+        ov::PartialShape shape = input.get_partial_shape();
+        bool image = known.image_input.empty() ?
+            shape.rank().is_static() && shape.rank().get_length() == 4 : name == known.image_input;
+        if (image) {
+            info.image_input = name;
+            if (shape.rank().is_static() && shape.rank().get_length() == 4) {
+                int height = static_length(shape[2]);
+                int width = static_length(shape[3]);
+                if (height > 0 && width > 0) {
+                    info.input_size = cv::Size(width, height);
+                }
+            }
+        } else if (name != known.shape_input && name != known.scale_input) {
+            extra_inputs.push_back(input);
+        }
+    }
+    if (info.image_input.empty()) {
+        throw std::runtime_error("The model has no [N,3,H,W] image input.");
+    }
+    if (post_flag) {
+        size_t missing = (info.shape_input.empty() ? 1 : 0) + (info.scale_input.empty() ? 1 : 0);
+        if (extra_inputs.size() != missing) {
+            throw std::runtime_error("The post-processed model must have im_shape and scale_factor inputs.");
+        }
+        if (missing == 2) {
+            bool swapped = name_contains(extra_inputs[0], "scale") || name_contains(extra_inputs[1], "shape");
+            info.shape_input = extra_inputs[swapped ? 1 : 0].get_any_name();
+            info.scale_input = extra_inputs[swapped ? 0 : 1].get_any_name();
+        } else if (missing == 1) {
+            (info.shape_input.empty() ? info.shape_input : info.scale_input) = extra_inputs[0].get_any_name();
+        }
+    }
+
+    std::vector<ov::Output<ov::Node>> outputs = model->outputs();
+    std::vector<int> head_outputs;
+    for (int i = 0; i < (int)outputs.size(); ++i) {
+        ov::PartialShape shape = outputs[i].get_partial_shape();
+        int rank = shape.rank().is_static() ? (int)shape.rank().get_length() : -1;
+        if (post_flag) {
+            if (known.result_index < 0 && rank == 2 && static_length(shape[1]) == 6) {
+                info.result_index = i;
+            } else if (known.result_num_index < 0 && rank == 1 && i != known.result_index) {
+                info.result_num_index = i;
+            }
+        } else if (rank == 3 && i != known.score_index && i != known.bbox_index) {
+            head_outputs.push_back(i);
+        }
+    }
+    if (post_flag) {
+        if (info.result_index < 0) {
+            throw std::runtime_error("The post-processed model has no [M,6] result output.");
+        }
+        ov::PartialShape result_shape = outputs[info.result_index].get_partial_shape();
+        bool matrix = result_shape.rank().is_static() && result_shape.rank().get_length() == 2;
+        info.num_queries = matrix ? static_length(result_shape[0]) : -1;
+        return info;
+    }
+
+    if (info.bbox_index < 0 && info.score_index < 0) {
+        if (head_outputs.size() != 2) {
+            throw std::runtime_error("The raw head model must have one box output and one score output of "
+                "rank 3, name them in the model bundle otherwise.");
+        }
+        int first = head_outputs[0];
+        int second = head_outputs[1];
+        int first_dim = static_length(outputs[first].get_partial_shape()[2]);
+        int second_dim = static_length(outputs[second].get_partial_shape()[2]);
+        if (first_dim == 4 && second_dim != 4) {
+            info.bbox_index = first;
+            info.score_index = second;
+        } else if (second_dim == 4 && first_dim != 4) {
+            info.bbox_index = second;
+            info.score_index = first;
+        } else if (name_contains(outputs[second], "box") && !name_contains(outputs[first], "box")) {
+            info.bbox_index = second;
+            info.score_index = first;
+        } else {
+            info.bbox_index = first;
+            info.score_index = second;
+        }
+    } else if (info.bbox_index < 0) {
+        // The scores are named, the boxes are the only remaining [N,Q,4] output.
+        std::vector<int> boxes;
+        for (int i : head_outputs) {
+            if (static_length(outputs[i].get_partial_shape()[2]) == 4) {
+                boxes.push_back(i);
+            }
+        }
+        if (boxes.size() != 1) {
+            throw std::runtime_error("The box output of the raw head model is ambiguous, name it in the model bundle.");
+        }
+        info.bbox_index = boxes[0];
+    } else if (info.score_index < 0) {
+        if (head_outputs.size() != 1) {
+            throw std::runtime_error("The score output of the raw head model is ambiguous, name it in the model bundle.");
+        }
+        info.score_index = head_outputs[0];
+    }
+    ov::PartialShape score_shape = outputs[info.score_index].get_partial_shape();
+    if (score_shape.rank().is_dynamic() || score_shape.rank().get_length() != 3) {
+        throw std::runtime_error("The score output of the raw head model must be [N,Q,C].");
+    }
+    info.num_queries = static_length(score_shape[1]);
+    info.num_classes = static_length(score_shape[2]);
+    if (info.num_classes <= 0) {
+        throw std::runtime_error("The class dimension of the score output must be static.");
+    }
+    return info;
+}
+
+/**
+ * The function `reshape_inputs` fixes the input shapes of the model before it is compiled. Exported
+ * models often keep the batch and image dimensions dynamic, which makes the CPU plugin fall back to
+ * shape-agnostic kernels and re-plan every inference. Without `max_size` every input is made static:
+ * batch 1 and the image at `info.input_size`. With `max_size` the image dimensions become a bounded
+ * range up to it (aligned down to `INPUT_STRIDE`), and `info` is updated accordingly.
+ *
+ * @param model The model read from disk, reshaped in place.
+ * @param info The roles of the model inputs, see `read_model_info`.
+ * @param max_size The largest image input of a dynamic model, empty for a static input.
+ *
+ * @return whether the model was reshaped. A std::runtime_error is thrown if the image input is not of
+ * rank 4, an ov::Exception if the model does not support the requested shapes.
+ */
+bool reshape_inputs(std::shared_ptr<ov::Model> model, ModelInfo& info, cv::Size max_size) {
+    std::map<std::string, ov::PartialShape> shapes;
+    bool reshape_flag = false;
+    if (max_size.area() > 0) {
+        max_size.width = std::max(max_size.width / INPUT_STRIDE, 1) * INPUT_STRIDE;
+        max_size.height = std::max(max_size.height / INPUT_STRIDE, 1) * INPUT_STRIDE;
+        shapes[info.image_input] = ov::PartialShape{ 1, 3, ov::Dimension(INPUT_STRIDE, max_size.height),
+            ov::Dimension(INPUT_STRIDE, max_size.width) };
+        info.input_size = max_size;
+        info.dynamic_input = true;
+        reshape_flag = true;
+    } else {
+        shapes[info.image_input] = ov::PartialShape{ 1, 3, info.input_size.height, info.input_size.width };
+    }
+    if (info.post_flag) {
+        shapes[info.shape_input] = ov::PartialShape{ 1, 2 };
+        shapes[info.scale_input] = ov::PartialShape{ 1, 2 };
+    }
+    // A model exported with static shapes already matches, reshaping it would only cost load time.
+    for (auto input : model->inputs()) {
+        ov::PartialShape shape = input.get_partial_shape();
+        bool image = input.get_any_name() == info.image_input;
+        if (image && (shape.rank().is_dynamic() || shape.rank().get_length() != 4)) {
+            throw std::runtime_error("The image input \"" + info.image_input + "\" must be [N,3,H,W].");
+        }
+        reshape_flag = reshape_flag || shape.is_dynamic() ||
+            (image && cv::Size(static_length(shape[3]), static_length(shape[2])) != info.input_size);
+    }
+    if (reshape_flag) {
+        model->reshape(shapes);
+    }
+    return reshape_flag;
+}
+
+/**
+ * The function returns the input size of a dynamic model for an image: the image scaled down to fit
+ * `max_size` with its aspect ratio kept, rounded to `INPUT_STRIDE`. Small images are not scaled up.
+ */
+cv::Size dynamic_input_size(int width, int height, cv::Size max_size) {
+    double scale = std::min(1.0, std::min((double)max_size.width / width, (double)max_size.height / height));
+    int w = (int)std::lround(width * scale / INPUT_STRIDE) * INPUT_STRIDE;
+    int h = (int)std::lround(height * scale / INPUT_STRIDE) * INPUT_STRIDE;
+    return cv::Size(std::min(std::max(w, INPUT_STRIDE), max_size.width),
+        std::min(std::max(h, INPUT_STRIDE), max_size.height));
+}
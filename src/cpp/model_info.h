@@ -0,0 +1,49 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  09:12:31
+// @Brief  : This is common class.
+// @File    : model_info.h
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : 
+#ifndef __MODEL_INFO_H__
+#define __MODEL_INFO_H__
+
+#include <memory>
+#include <string>
+
+#include "openvino/openvino.hpp"
+#include "opencv2/opencv.hpp"
+
+// The input and output roles of an RT-DETR model, resolved from the model shapes at load time. An
+// empty name or a negative index is a role still to be resolved.
+struct ModelInfo {
+    bool post_flag;                 // Whether the model includes the post-processing layers.
+    std::string image_input;        // The [N,3,H,W] image input.
+    std::string shape_input;        // The [N,2] im_shape input (post-processed model only).
+    std::string scale_input;        // The [N,2] scale_factor input (post-processed model only).
+    int result_index;               // The [M,6] result output (post-processed model only).
+    int result_num_index;           // The [N] result count output, -1 if the model has none.
+    int score_index;                // The [N,Q,C] class logits output (raw head model only).
+    int bbox_index;                 // The [N,Q,4] box output (raw head model only).
+    cv::Size input_size;            // The model input size, the upper bound if `dynamic_input`.
+    bool dynamic_input;             // Whether the image input takes any size up to `input_size`.
+    int num_queries;                // The number of decoder queries, -1 if dynamic.
+    int num_classes;                // The number of classes, -1 if unknown.
+    ModelInfo() : post_flag(true), result_index(-1), result_num_index(-1), score_index(-1),
+        bbox_index(-1), input_size(640, 640), dynamic_input(false), num_queries(-1), num_classes(-1) {}
+};
+
+// The stride of the backbone, a dynamic image input is a multiple of it.
+const int INPUT_STRIDE = 32;
+
+ModelInfo read_model_info(std::shared_ptr<ov::Model> model, bool post_flag,
+    const ModelInfo& known = ModelInfo());
+
+bool reshape_inputs(std::shared_ptr<ov::Model> model, ModelInfo& info, cv::Size max_size = cv::Size());
+
+cv::Size dynamic_input_size(int width, int height, cv::Size max_size);
+
+#endif // !__MODEL_INFO_H__
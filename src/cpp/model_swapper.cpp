@@ -0,0 +1,162 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  21:12:50
+// @Brief  : This is common class.
+// @File    : model_swapper.cpp
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : 
+
+#include "model_swapper.h"
+#include <algorithm>
+#include <chrono>
+
+
+// How long the reload thread waits for the old predictor to drain before it leaves the release to
+// its last user.
+static const int DRAIN_TIMEOUT_MS = 60000;
+// The longest pause between two checks of the drain, the pauses grow from 50 us up to it.
+static const int DRAIN_POLL_MAX_US = 20000;
+
+/**
+ * The ModelSwapper constructor builds and warms up the first predictor on the calling thread.
+ *
+ * @param bundle The model to serve, see `load_bundle`.
+ * @param device_name The device of this and every later predictor.
+ * @param options The predictor options of this and every later predictor, at least one warm-up round
+ * is always run.
+ */
+ModelSwapper::ModelSwapper(const ModelBundle& bundle, std::string device_name, const PredictorOptions& options)
+    : bundle(bundle), device_name(device_name), options(options), reloading(false) {
+    this->options.warmup_iterations = std::max(options.warmup_iterations, 1);
+    std::shared_ptr<RTDETRPredictor> first = std::make_shared<RTDETRPredictor>(bundle, device_name, this->options);
+    std::atomic_store(&engine, first);
+    stats.generation = 0;
+    stats.reloading = false;
+    stats.load_ms = stats.warmup_ms = stats.swap_us = stats.drain_ms = 0.0;
+}
+
+/**
+ * The destructor waits for a running reload, including the drain of the old predictor.
+ */
+ModelSwapper::~ModelSwapper() {
+    std::thread running;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running.swap(worker);
+    }
+    if (running.joinable()) {
+        running.join();
+    }
+}
+
+/**
+ * The function `reload` rebuilds the predictor from the current bundle, e.g. after its files were
+ * replaced in place.
+ *
+ * @return false if a reload is already running.
+ */
+bool ModelSwapper::reload() {
+    ModelBundle current;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        current = bundle;
+    }
+    return reload(current);
+}
+
+/**
+ * The function `reload` starts building a predictor for another bundle in the background and returns
+ * at once. The current predictor keeps serving until the new one is compiled and warmed up; a failed
+ * reload leaves it in place and reports the error in `get_stats`.
+ *
+ * @return false if a reload is already running.
+ */
+bool ModelSwapper::reload(const ModelBundle& bundle) {
+    std::lock_guard<std::mutex> lock(mutex);
+    bool expected = false;
+    if (!reloading.compare_exchange_strong(expected, true)) {
+        return false;
+    }
+    // The previous reload thread has already left its last critical section, the join does not wait.
+    if (worker.joinable()) {
+        worker.join();
+    }
+    stats.reloading = true;
+    worker = std::thread(&ModelSwapper::run_reload, this, bundle);
+    return true;
+}
+
+SwapStats ModelSwapper::get_stats() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+/**
+ * The reload thread: build, warm up, swap, then wait for the old predictor to drain. The thread keeps
+ * a reference to the old predictor until the requests in flight on it have dropped theirs, so that it
+ * is destroyed here and not on a serving thread. Only if it is still in use after DRAIN_TIMEOUT_MS is
+ * it left to its last user.
+ */
+void ModelSwapper::run_reload(ModelBundle next) {
+    typedef std::chrono::steady_clock clock;
+    auto t1 = clock::now();
+    std::shared_ptr<RTDETRPredictor> replacement;
+    try {
+        // The constructor compiles and warms up, the serving threads are not involved.
+        replacement = std::make_shared<RTDETRPredictor>(next, device_name, options);
+    }
+    catch (const std::exception& e) {
+        INFO("The reload failed: " << e.what());
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.error = e.what();
+        stats.reloading = false;
+        reloading = false;
+        return;
+    }
+    double warmup_ms = replacement->get_warmup_stats().warmup_ms;
+    double load_ms = std::chrono::duration<double, std::milli>(clock::now() - t1).count() - warmup_ms;
+
+    auto t3 = clock::now();
+    std::shared_ptr<RTDETRPredictor> old = std::atomic_exchange(&engine, replacement);
+    auto t4 = clock::now();
+    replacement.reset();
+    uint64_t generation;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        bundle = next;
+        generation = ++stats.generation;
+        stats.load_ms = load_ms;
+        stats.warmup_ms = warmup_ms;
+        stats.swap_us = std::chrono::duration<double, std::micro>(t4 - t3).count();
+        stats.drain_ms = -1.0;
+        stats.error.clear();
+    }
+    INFO("Swapped in model generation " << generation << ": load " << load_ms << " ms, warm-up "
+        << warmup_ms << " ms.");
+
+    // No new reference to the old predictor can be taken after the swap, so once this thread holds
+    // the only one the drain is complete. The pauses back off, a short drain is seen within
+    // microseconds and a long one costs few wake-ups.
+    auto deadline = t4 + std::chrono::milliseconds(DRAIN_TIMEOUT_MS);
+    std::chrono::microseconds pause(50);
+    while (old.use_count() > 1 && clock::now() < deadline) {
+        std::this_thread::sleep_for(pause);
+        pause = std::min(pause * 2, std::chrono::microseconds(DRAIN_POLL_MAX_US));
+    }
+    bool drained = old.use_count() == 1;
+    double drain_ms = std::chrono::duration<double, std::milli>(clock::now() - t4).count();
+    if (!drained) {
+        INFO("The model generation " << generation - 1 << " is still in use after " << DRAIN_TIMEOUT_MS
+            << " ms, its last user releases it.");
+    }
+    old.reset();
+    std::lock_guard<std::mutex> lock(mutex);
+    if (drained) {
+        stats.drain_ms = drain_ms;
+    }
+    stats.reloading = false;
+    reloading = false;
+}
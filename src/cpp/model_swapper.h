@@ -0,0 +1,62 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  21:03:24
+// @Brief  : This is common class.
+// @File    : model_swapper.h
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : Hot model swap. The serving threads take the current predictor through a shared
+//                pointer; a replacement is built and warmed up on a background thread, then swapped
+//                in atomically while the requests in flight on the old one finish.
+#ifndef __MODEL_SWAPPER_H__
+#define __MODEL_SWAPPER_H__
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "model_bundle.h"
+#include "rtdert_predictor.h"
+
+struct SwapStats {
+    uint64_t generation;        // The swaps done so far.
+    bool reloading;             // Whether a replacement is being built or the old predictor drains.
+    double load_ms;             // The read_model and compile_model time of the last replacement.
+    double warmup_ms;           // Its warm-up time, before it was swapped in.
+    double swap_us;             // The time the swap itself took on the reload thread.
+    double drain_ms;            // From the swap until the old predictor was released, -1 while draining.
+    std::string error;          // Why the last reload failed, empty if it did not.
+};
+
+class ModelSwapper
+{
+public:
+    ModelSwapper(const ModelBundle& bundle, std::string device_name, const PredictorOptions& options);
+    ~ModelSwapper();
+    std::shared_ptr<RTDETRPredictor> acquire() const { return std::atomic_load(&engine); }
+    bool reload();
+    bool reload(const ModelBundle& bundle);
+    SwapStats get_stats();
+
+private:
+    ModelSwapper(const ModelSwapper&);
+    ModelSwapper& operator=(const ModelSwapper&);
+    void run_reload(ModelBundle bundle);
+
+private:
+    std::shared_ptr<RTDETRPredictor> engine;    // Only accessed with std::atomic_load/atomic_store.
+    ModelBundle bundle;                         // The source of the current predictor.
+    std::string device_name;
+    PredictorOptions options;
+    std::atomic<bool> reloading;
+    std::mutex mutex;                           // Guards `bundle`, `stats` and `worker`.
+    SwapStats stats;
+    std::thread worker;
+};
+
+#endif // !__MODEL_SWAPPER_H__
@@ -0,0 +1,399 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  11:03:15
+// @Brief  : This is common class.
+// @File    : nms.cpp
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : 
+
+#include "nms.h"
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <utility>
+
+
+void BoxSet::clear() {
+    x1.clear(); y1.clear(); x2.clear(); y2.clear();
+    scores.clear();
+    clsids.clear();
+    indexs.clear();
+}
+
+void BoxSet::reserve(size_t n) {
+    x1.reserve(n); y1.reserve(n); x2.reserve(n); y2.reserve(n);
+    scores.reserve(n);
+    clsids.reserve(n);
+    indexs.reserve(n);
+}
+
+void BoxSet::push_back(float bx1, float by1, float bx2, float by2, float score, int clsid, int index) {
+    x1.push_back(bx1); y1.push_back(by1); x2.push_back(bx2); y2.push_back(by2);
+    scores.push_back(score);
+    clsids.push_back(clsid);
+    indexs.push_back(index);
+}
+
+/**
+ * The function `run` suppresses the duplicate boxes in place. Afterwards `boxes` holds the kept boxes
+ * in descending score order, with the scores decayed by soft-NMS and the coordinates fused by the
+ * weighted method.
+ *
+ * @param boxes The candidate boxes.
+ */
+void BoxSuppressor::run(BoxSet& boxes) {
+    if (config.method == NmsMethod::NONE || boxes.size() == 0) {
+        return;
+    }
+    sort_boxes(boxes);
+    // The grid pays off once a class segment is large, e.g. for class-agnostic suppression.
+    int max_segment = 0;
+    for (int i = 0; i < count; i = segment_end[i]) {
+        max_segment = std::max(max_segment, segment_end[i] - i);
+    }
+    use_grid = max_segment >= config.bucket_min_boxes;
+    if (use_grid) {
+        build_grid();
+    }
+    kept.clear();
+    switch (config.method) {
+    case NmsMethod::HARD: run_hard(); break;
+    case NmsMethod::SOFT_LINEAR:
+    case NmsMethod::SOFT_GAUSSIAN: run_soft(); break;
+    case NmsMethod::WEIGHTED: run_weighted(); break;
+    default: break;
+    }
+    boxes.clear();
+    for (int i : kept) {
+        boxes.push_back(sx1[i], sy1[i], sx2[i], sy2[i], sscore[i], scls[i], sindex[i]);
+    }
+}
+
+/**
+ * The function `sort_boxes` gathers the candidates into the sorted SoA buffers, so that the suppression
+ * loops run over contiguous arrays in descending score order.
+ */
+void BoxSuppressor::sort_boxes(const BoxSet& boxes) {
+    count = (int)boxes.size();
+    order.resize(count);
+    for (int i = 0; i < count; ++i) {
+        order[i] = i;
+    }
+    // With class-aware suppression the boxes are grouped by class, so that a box is only compared with
+    // the contiguous segment of its own class.
+    const float* score = boxes.scores.data();
+    const int* cls = boxes.clsids.data();
+    if (config.class_aware) {
+        std::sort(order.begin(), order.end(), [score, cls](int a, int b) {
+            return cls[a] != cls[b] ? cls[a] < cls[b] : score[a] > score[b];
+        });
+    } else {
+        std::sort(order.begin(), order.end(), [score](int a, int b) { return score[a] > score[b]; });
+    }
+    sx1.resize(count); sy1.resize(count); sx2.resize(count); sy2.resize(count);
+    sarea.resize(count); sscore.resize(count);
+    scls.resize(count); sindex.resize(count);
+    for (int i = 0; i < count; ++i) {
+        int k = order[i];
+        sx1[i] = boxes.x1[k];
+        sy1[i] = boxes.y1[k];
+        sx2[i] = boxes.x2[k];
+        sy2[i] = boxes.y2[k];
+        sarea[i] = std::max(sx2[i] - sx1[i], 0.0f) * std::max(sy2[i] - sy1[i], 0.0f);
+        sscore[i] = boxes.scores[k];
+        scls[i] = config.class_aware ? boxes.clsids[k] : 0;
+        sindex[i] = boxes.indexs[k];
+    }
+    segment_start.resize(count);
+    segment_end.resize(count);
+    for (int i = 0; i < count; ++i) {
+        segment_start[i] = i > 0 && scls[i - 1] == scls[i] ? segment_start[i - 1] : i;
+    }
+    for (int i = count - 1; i >= 0; --i) {
+        segment_end[i] = i + 1 < count && scls[i + 1] == scls[i] ? segment_end[i + 1] : i + 1;
+    }
+    removed.assign(count, 0);
+    hits.resize(count);
+    visited.assign(count, 0);
+    visit_mark = 0;
+}
+
+/**
+ * The function `build_grid` buckets the sorted boxes into a uniform grid whose cell size is the mean
+ * box size, so that every box only has to be compared with the boxes in the cells it overlaps. The
+ * cells are stored as one flat array with start offsets (counting sort), in ascending sorted position.
+ */
+void BoxSuppressor::build_grid() {
+    float min_x = sx1[0], min_y = sy1[0], max_x = sx2[0], max_y = sy2[0];
+    double sum_w = 0, sum_h = 0;
+    for (int i = 0; i < count; ++i) {
+        min_x = std::min(min_x, sx1[i]);
+        min_y = std::min(min_y, sy1[i]);
+        max_x = std::max(max_x, sx2[i]);
+        max_y = std::max(max_y, sy2[i]);
+        sum_w += sx2[i] - sx1[i];
+        sum_h += sy2[i] - sy1[i];
+    }
+    const int max_cells = 64;
+    cell_w = std::max((float)(sum_w / count), (max_x - min_x) / max_cells);
+    cell_h = std::max((float)(sum_h / count), (max_y - min_y) / max_cells);
+    cell_w = std::max(cell_w, 1e-3f);
+    cell_h = std::max(cell_h, 1e-3f);
+    grid_x0 = min_x;
+    grid_y0 = min_y;
+    grid_w = std::min(max_cells, (int)((max_x - min_x) / cell_w) + 1);
+    grid_h = std::min(max_cells, (int)((max_y - min_y) / cell_h) + 1);
+
+    cell_start.assign(grid_w * grid_h + 1, 0);
+    for (int pass = 0; pass < 2; ++pass) {
+        if (pass == 1) {
+            for (int c = 0; c < grid_w * grid_h; ++c) {
+                cell_start[c + 1] += cell_start[c];
+            }
+            cell_items.resize(cell_start[grid_w * grid_h]);
+        }
+        std::vector<int> fill(pass == 1 ? cell_start : std::vector<int>());
+        for (int i = 0; i < count; ++i) {
+            int cx0 = std::min(grid_w - 1, std::max(0, (int)((sx1[i] - grid_x0) / cell_w)));
+            int cx1 = std::min(grid_w - 1, std::max(0, (int)((sx2[i] - grid_x0) / cell_w)));
+            int cy0 = std::min(grid_h - 1, std::max(0, (int)((sy1[i] - grid_y0) / cell_h)));
+            int cy1 = std::min(grid_h - 1, std::max(0, (int)((sy2[i] - grid_y0) / cell_h)));
+            for (int cy = cy0; cy <= cy1; ++cy) {
+                for (int cx = cx0; cx <= cx1; ++cx) {
+                    int c = cy * grid_w + cx;
+                    if (pass == 0) {
+                        ++cell_start[c + 1];
+                    } else {
+                        cell_items[fill[c]++] = i;
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * The function `for_each_neighbor` calls `f(j)` once for every remaining box `j` of the same class that
+ * may overlap box `i`: with the grid, the boxes sharing a cell with it, otherwise all boxes.
+ *
+ * @param i The sorted position of the box.
+ * @param below_only Whether only the boxes ranked below `i` are visited.
+ * @param f The function called with the sorted position of every neighbor.
+ */
+template<class F>
+void BoxSuppressor::for_each_neighbor(int i, bool below_only, F f) {
+    if (!use_grid) {
+        int end = segment_end[i];
+        for (int j = below_only ? i + 1 : segment_start[i]; j < end; ++j) {
+            if (j != i && !removed[j]) {
+                f(j);
+            }
+        }
+        return;
+    }
+    ++visit_mark;
+    visited[i] = visit_mark;
+    int cx0 = std::min(grid_w - 1, std::max(0, (int)((sx1[i] - grid_x0) / cell_w)));
+    int cx1 = std::min(grid_w - 1, std::max(0, (int)((sx2[i] - grid_x0) / cell_w)));
+    int cy0 = std::min(grid_h - 1, std::max(0, (int)((sy1[i] - grid_y0) / cell_h)));
+    int cy1 = std::min(grid_h - 1, std::max(0, (int)((sy2[i] - grid_y0) / cell_h)));
+    for (int cy = cy0; cy <= cy1; ++cy) {
+        for (int cx = cx0; cx <= cx1; ++cx) {
+            int c = cy * grid_w + cx;
+            // The cell lists are in ascending sorted position, so the boxes ranked below `i` are a suffix.
+            const int* begin = cell_items.data() + cell_start[c];
+            const int* end = cell_items.data() + cell_start[c + 1];
+            for (const int* p = below_only ? std::upper_bound(begin, end, i) : begin; p < end; ++p) {
+                int j = *p;
+                if (visited[j] != visit_mark && !removed[j] && scls[j] == scls[i]) {
+                    visited[j] = visit_mark;
+                    f(j);
+                }
+            }
+        }
+    }
+}
+
+float BoxSuppressor::iou(int i, int j) const {
+    float w = std::min(sx2[i], sx2[j]) - std::max(sx1[i], sx1[j]);
+    float h = std::min(sy2[i], sy2[j]) - std::max(sy1[i], sy1[j]);
+    float inter = std::max(w, 0.0f) * std::max(h, 0.0f);
+    float uni = sarea[i] + sarea[j] - inter;
+    return uni > 0.0f ? inter / uni : 0.0f;
+}
+
+/**
+ * The function `mark_overlaps` sets `mark[j]` for every box `j` ranked below box `i` in its class
+ * segment that overlaps it by more than the IoU threshold. It is a branch-free loop over the sorted
+ * arrays that the compiler vectorizes.
+ */
+void BoxSuppressor::mark_overlaps(int i, int* mark) {
+    const float thr = config.iou_threshold;
+    const float bx1 = sx1[i], by1 = sy1[i], bx2 = sx2[i], by2 = sy2[i], barea = sarea[i];
+    const float *px1 = sx1.data(), *py1 = sy1.data(), *px2 = sx2.data(), *py2 = sy2.data();
+    const float* parea = sarea.data();
+    const int end = segment_end[i];
+    for (int j = i + 1; j < end; ++j) {
+        float w = (px2[j] < bx2 ? px2[j] : bx2) - (px1[j] > bx1 ? px1[j] : bx1);
+        float h = (py2[j] < by2 ? py2[j] : by2) - (py1[j] > by1 ? py1[j] : by1);
+        float inter = (w > 0.0f ? w : 0.0f) * (h > 0.0f ? h : 0.0f);
+        // inter / union > thr, without the division.
+        mark[j] |= (int)(inter > thr * (barea + parea[j] - inter));
+    }
+}
+
+/**
+ * The function `run_hard` runs greedy NMS. Within a class the boxes are visited in descending score
+ * order, so a class stops as soon as `max_detections` of its boxes are kept. Without the grid, the
+ * suppression of the rest of the class segment is a branch-free loop over the sorted arrays that the
+ * compiler vectorizes; with it, only the lower ranked boxes sharing a cell are tested.
+ */
+void BoxSuppressor::run_hard() {
+    const int limit = config.max_detections > 0 ? config.max_detections : count;
+    int class_kept = 0;
+    for (int i = 0; i < count; ++i) {
+        if (i == 0 || scls[i] != scls[i - 1]) {
+            class_kept = 0;
+        }
+        if (class_kept >= limit) {
+            i = segment_end[i] - 1;
+            continue;
+        }
+        if (removed[i]) {
+            continue;
+        }
+        kept.push_back(i);
+        ++class_kept;
+        if (use_grid) {
+            for_each_neighbor(i, true, [&](int j) {
+                if (iou(i, j) > config.iou_threshold) {
+                    removed[j] = 1;
+                }
+            });
+        } else {
+            mark_overlaps(i, removed.data());
+        }
+    }
+    sort_kept(limit);
+}
+
+/**
+ * The function `run_soft` runs soft-NMS. Since the scores only ever decrease, the next box to keep is
+ * taken from a lazy max-heap: an entry whose score is stale is skipped, the decayed box was pushed
+ * again with its new score. The loop stops once `max_detections` boxes are kept or the best remaining
+ * score is below `score_threshold`.
+ */
+void BoxSuppressor::run_soft() {
+    const int limit = config.max_detections > 0 ? config.max_detections : count;
+    const bool gaussian = config.method == NmsMethod::SOFT_GAUSSIAN;
+    typedef std::pair<float, int> Entry;
+    std::priority_queue<Entry> queue;
+    for (int i = 0; i < count; ++i) {
+        if (sscore[i] >= config.score_threshold) {
+            queue.push(Entry(sscore[i], -i));
+        } else {
+            removed[i] = 1;
+        }
+    }
+    // The heap orders equal scores by ascending sorted position. A kept box is flagged as removed
+    // too, so that it is neither popped nor decayed again.
+    while (!queue.empty() && (int)kept.size() < limit) {
+        Entry top = queue.top();
+        queue.pop();
+        int i = -top.second;
+        if (removed[i] || top.first != sscore[i]) {
+            continue;
+        }
+        removed[i] = 1;
+        kept.push_back(i);
+        auto decay = [&](int j) {
+            float o = iou(i, j);
+            float weight = gaussian ? std::exp(-(o * o) / config.sigma) : (o > config.iou_threshold ? 1.0f - o : 1.0f);
+            if (weight >= 1.0f) {
+                return;
+            }
+            sscore[j] *= weight;
+            if (sscore[j] < config.score_threshold) {
+                removed[j] = 1;
+            } else {
+                queue.push(Entry(sscore[j], -j));
+            }
+        };
+        // Boxes ranked above `i` by the initial order may still be pending after their own decay.
+        for_each_neighbor(i, false, decay);
+    }
+}
+
+/**
+ * The function `run_weighted` runs weighted box fusion: every kept box absorbs the boxes it overlaps,
+ * and its coordinates become the score-weighted mean of the cluster. The kept box keeps its own
+ * (highest) score, so the fused scores stay comparable with the other methods.
+ */
+void BoxSuppressor::run_weighted() {
+    const int limit = config.max_detections > 0 ? config.max_detections : count;
+    const float thr = config.iou_threshold;
+    int class_kept = 0;
+    for (int i = 0; i < count; ++i) {
+        if (i == 0 || scls[i] != scls[i - 1]) {
+            class_kept = 0;
+        }
+        if (class_kept >= limit) {
+            i = segment_end[i] - 1;
+            continue;
+        }
+        if (removed[i]) {
+            continue;
+        }
+        kept.push_back(i);
+        ++class_kept;
+        float w = sscore[i];
+        float fx1 = sx1[i] * w, fy1 = sy1[i] * w, fx2 = sx2[i] * w, fy2 = sy2[i] * w;
+        float sum = w;
+        auto merge = [&](int j) {
+            removed[j] = 1;
+            fx1 += sx1[j] * sscore[j];
+            fy1 += sy1[j] * sscore[j];
+            fx2 += sx2[j] * sscore[j];
+            fy2 += sy2[j] * sscore[j];
+            sum += sscore[j];
+        };
+        if (use_grid) {
+            for_each_neighbor(i, true, [&](int j) {
+                if (iou(i, j) > thr) {
+                    merge(j);
+                }
+            });
+        } else {
+            const int end = segment_end[i];
+            std::fill(hits.begin() + i + 1, hits.begin() + end, 0);
+            mark_overlaps(i, hits.data());
+            for (int j = i + 1; j < end; ++j) {
+                if (hits[j] && !removed[j]) {
+                    merge(j);
+                }
+            }
+        }
+        // The IoU tests above use the original box, it is only replaced once its cluster is complete.
+        sx1[i] = fx1 / sum;
+        sy1[i] = fy1 / sum;
+        sx2[i] = fx2 / sum;
+        sy2[i] = fy2 / sum;
+    }
+    sort_kept(limit);
+}
+
+/**
+ * The function `sort_kept` merges the kept boxes of all classes into descending score order, and
+ * applies the `max_detections` limit across classes.
+ */
+void BoxSuppressor::sort_kept(int limit) {
+    if (config.class_aware) {
+        std::stable_sort(kept.begin(), kept.end(), [this](int a, int b) { return sscore[a] > sscore[b]; });
+    }
+    if ((int)kept.size() > limit) {
+        kept.resize(limit);
+    }
+}
@@ -0,0 +1,95 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  11:02:47
+// @Brief  : This is common class.
+// @File    : nms.h
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : 
+#ifndef __NMS_H__
+#define __NMS_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+// The duplicate suppression method.
+enum class NmsMethod {
+    NONE,               // No suppression.
+    HARD,               // Greedy NMS, overlapping boxes are dropped.
+    SOFT_LINEAR,        // Soft-NMS, overlapping scores are scaled by (1 - IoU).
+    SOFT_GAUSSIAN,      // Soft-NMS, overlapping scores are scaled by exp(-IoU^2 / sigma).
+    WEIGHTED,           // Weighted box fusion, overlapping boxes are merged into the best one.
+};
+
+struct NmsConfig {
+    NmsMethod method;
+    float iou_threshold;    // The IoU above which boxes overlap.
+    float sigma;            // The Gaussian soft-NMS parameter.
+    float score_threshold;  // The score below which soft-NMS drops a box.
+    bool class_aware;       // Whether only boxes of the same class suppress each other.
+    int max_detections;     // Stop once this many boxes are kept, 0 for no limit.
+    int bucket_min_boxes;   // The per-class candidate count from which spatial bucketing is used.
+    NmsConfig() : method(NmsMethod::NONE), iou_threshold(0.5f), sigma(0.5f), score_threshold(0.001f),
+        class_aware(true), max_detections(0), bucket_min_boxes(256) {}
+};
+
+// A set of boxes stored as separate coordinate, score and class arrays (SoA).
+struct BoxSet {
+    std::vector<float> x1, y1, x2, y2;
+    std::vector<float> scores;
+    std::vector<int> clsids;
+    std::vector<int> indexs;    // The caller's index of every box, e.g. the query id.
+
+    size_t size() const { return scores.size(); }
+    void clear();
+    void reserve(size_t n);
+    void push_back(float bx1, float by1, float bx2, float by2, float score, int clsid, int index);
+};
+
+
+class BoxSuppressor
+{
+public:
+    BoxSuppressor() {}
+    explicit BoxSuppressor(const NmsConfig& config) : config(config) {}
+    void set_config(const NmsConfig& config) { this->config = config; }
+    NmsConfig get_config() { return config; }
+    void run(BoxSet& boxes);
+
+private:
+    void sort_boxes(const BoxSet& boxes);
+    void build_grid();
+    template<class F>
+    void for_each_neighbor(int i, bool below_only, F f);
+    float iou(int i, int j) const;
+    void mark_overlaps(int i, int* mark);
+    void run_hard();
+    void run_soft();
+    void run_weighted();
+    void sort_kept(int limit);
+
+private:
+    NmsConfig config;
+    int count;                          // The number of candidate boxes.
+    bool use_grid;                      // Whether the neighbors are found through the grid.
+    // The candidates sorted by descending score, the buffers are reused across calls.
+    std::vector<float> sx1, sy1, sx2, sy2, sarea, sscore;
+    std::vector<int> scls, sindex, order;
+    std::vector<int> segment_start, segment_end;    // The class segment of each box.
+    std::vector<int> removed;
+    std::vector<int> hits;
+    std::vector<int> kept;
+    std::vector<int> visited;           // The last neighbor query that visited each box.
+    int visit_mark;
+    // The spatial grid, every cell lists the sorted positions of the boxes overlapping it.
+    int grid_w, grid_h;
+    float grid_x0, grid_y0, cell_w, cell_h;
+    std::vector<int> cell_start, cell_items;
+};
+
+
+#endif // !__NMS_H__
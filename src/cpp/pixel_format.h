@@ -0,0 +1,68 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  14:05:33
+// @Brief  : This is common class.
+// @File    : pixel_format.h
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : 
+#ifndef __PIXEL_FORMAT_H__
+#define __PIXEL_FORMAT_H__
+
+#include <cstddef>
+
+// The pixel layout of a caller-owned 8-bit image buffer. The values are shared with other processes,
+// so they must not change.
+enum class PixelFormat {
+    BGR = 0,    // Packed 3 channels.
+    RGB = 1,
+    BGRA = 2,   // Packed 4 channels, the alpha channel is ignored.
+    RGBA = 3,
+    GRAY = 4,   // 1 channel.
+    NV12 = 5,   // Y plane followed by an interleaved UV plane at half resolution.
+    NV21 = 6,   // Y plane followed by an interleaved VU plane at half resolution.
+    I420 = 7,   // Y, U and V planes, U and V at half resolution.
+};
+
+// The number of bytes of a tightly packed image, with the chroma planes of the YUV formats following
+// the Y plane.
+inline size_t packed_image_bytes(PixelFormat format, int width, int height) {
+    size_t area = (size_t)width * height;
+    size_t chroma = (size_t)((width + 1) / 2) * ((height + 1) / 2);
+    switch (format) {
+    case PixelFormat::BGR:
+    case PixelFormat::RGB: return area * 3;
+    case PixelFormat::BGRA:
+    case PixelFormat::RGBA: return area * 4;
+    case PixelFormat::GRAY: return area;
+    default: return area + chroma * 2;
+    }
+}
+
+// The number of planes of a format: 1 for the packed formats, 2 for NV12/NV21 and 3 for I420.
+inline int plane_count(PixelFormat format) {
+    switch (format) {
+    case PixelFormat::NV12:
+    case PixelFormat::NV21: return 2;
+    case PixelFormat::I420: return 3;
+    default: return 1;
+    }
+}
+
+// The number of bytes of one row of a plane, the shortest stride the plane can have.
+inline size_t plane_row_bytes(PixelFormat format, int width, int plane) {
+    size_t chroma_width = (size_t)((width + 1) / 2);
+    switch (format) {
+    case PixelFormat::BGR:
+    case PixelFormat::RGB: return (size_t)width * 3;
+    case PixelFormat::BGRA:
+    case PixelFormat::RGBA: return (size_t)width * 4;
+    case PixelFormat::GRAY: return (size_t)width;
+    case PixelFormat::I420: return plane == 0 ? (size_t)width : chroma_width;
+    default: return plane == 0 ? (size_t)width : chroma_width * 2;
+    }
+}
+
+#endif // !__PIXEL_FORMAT_H__
@@ -10,8 +10,9 @@
 // @Description : 
 
 #include "process.h"
-#include <fstream>
+#include <functional>
 #include <iostream>
+#include <limits>
 #include "opencv2/opencv.hpp"
 
 
@@ -32,10 +33,102 @@
  */
 RTDETRProcess::RTDETRProcess(cv::Size target_size, std::string label_path, 
 	float threshold, cv::InterpolationFlags interpf)
-	: target_size(target_size), threshold(threshold), interpf(interpf){
+	: target_size(target_size), interpf(interpf), num_classes(0){
     if (!label_path.empty()) {
         read_labels(label_path);
     }
+    filter.threshold = threshold;
+    set_output_dims(300, 80);
+}
+
+/**
+ * The function `set_output_dims` sets the number of queries and classes of the model outputs, and
+ * selects the decode kernel for the class count. The common class counts get a kernel whose inner
+ * loop length is a compile time constant, other class counts fall back to the generic kernel.
+ * 
+ * @param num_queries The number of decoder queries (rows) in the model outputs.
+ * @param num_classes The number of classes of the score output of the raw head model.
+ */
+void RTDETRProcess::set_output_dims(int num_queries, int num_classes) {
+    this->num_queries = num_queries;
+    if (this->num_classes == num_classes) {
+        return;
+    }
+    this->num_classes = num_classes;
+    update_thresholds();
+    switch (num_classes) {
+    case 1: decode_fn = &RTDETRProcess::decode_queries<1>; break;
+    case 5: decode_fn = &RTDETRProcess::decode_queries<5>; break;
+    case 20: decode_fn = &RTDETRProcess::decode_queries<20>; break;
+    case 80: decode_fn = &RTDETRProcess::decode_queries<80>; break;
+    case 365: decode_fn = &RTDETRProcess::decode_queries<365>; break;
+    default: decode_fn = &RTDETRProcess::decode_queries<0>; break;
+    }
+}
+
+/**
+ * The function `set_filter` sets the detection filter applied inside the decode pass.
+ * 
+ * @param filter The FilterConfig object. Classes missing from `class_thresholds` use `threshold`,
+ * classes missing from a non-empty `allowed_classes` are dropped before their boxes are decoded, and
+ * a positive `max_detections` keeps only the highest scoring detections.
+ */
+void RTDETRProcess::set_filter(const FilterConfig& filter) {
+    this->filter = filter;
+    update_thresholds();
+}
+
+/**
+ * The function `update_thresholds` builds the per-class threshold tables from the filter. Dropped
+ * classes get an infinite threshold, so the decode loop needs no separate allow-list lookup. Since the
+ * sigmoid is monotonic, the raw head model compares the thresholds with the logits, and only evaluates
+ * the sigmoid for the detections that are kept.
+ */
+void RTDETRProcess::update_thresholds() {
+    const float inf = std::numeric_limits<float>::infinity();
+    int size = std::max(num_classes, labels ? labels->size() : 0);
+    size = std::max(size, (int)filter.class_thresholds.size());
+    for (int clsid : filter.allowed_classes) {
+        size = std::max(size, clsid + 1);
+    }
+    default_threshold = filter.allowed_classes.empty() ? filter.threshold : inf;
+    score_thresholds.assign(size, default_threshold);
+    for (int clsid : filter.allowed_classes) {
+        if (clsid >= 0) {
+            score_thresholds[clsid] = filter.threshold;
+        }
+    }
+    for (int i = 0; i < (int)filter.class_thresholds.size(); ++i) {
+        if (score_thresholds[i] != inf) {
+            score_thresholds[i] = filter.class_thresholds[i];
+        }
+    }
+    logit_thresholds.resize(size);
+    for (int i = 0; i < size; ++i) {
+        float t = score_thresholds[i];
+        if (t == inf || t >= 1.0f) {
+            logit_thresholds[i] = inf;
+        } else if (t <= 0.0f) {
+            logit_thresholds[i] = -inf;
+        } else {
+            logit_thresholds[i] = std::log(t / (1.0f - t));
+        }
+    }
+    heap.reserve(std::max(filter.max_detections, 0));
+    NmsConfig config = nms.get_config();
+    config.max_detections = filter.max_detections;
+    nms.set_config(config);
+}
+
+/**
+ * The function `set_nms` enables the host-side NMS stage, which removes the overlapping duplicates
+ * left by a low threshold. It runs on the detections kept by the filter, before the top-k limit.
+ * 
+ * @param config The NmsConfig object, its `max_detections` is taken from the filter.
+ */
+void RTDETRProcess::set_nms(const NmsConfig& config) {
+    nms.set_config(config);
+    update_thresholds();
 }
 
 /**
@@ -47,11 +140,10 @@ RTDETRProcess::RTDETRProcess(cv::Size target_size, std::string label_path,
  * @return a cv::Mat object, which is the preprocessed image.
  */
 cv::Mat RTDETRProcess::preprocess(cv::Mat image){
-    im_shape = { (float)image.rows, (float)image.cols };
-    scale_factor = { 640.0f / (float)image.rows, 640.0f / (float)image.cols};
+    set_image_size(image.rows, image.cols);
     cv::Mat blob_image;
     cv::cvtColor(image, blob_image, cv::COLOR_BGR2RGB); 
-    cv::resize(blob_image, blob_image, target_size, 0, 0, cv::INTER_LINEAR);
+    cv::resize(blob_image, blob_image, target_size, 0, 0, interpf);
     std::vector<cv::Mat> rgb_channels(3);
     cv::split(blob_image, rgb_channels);
     for (auto i = 0; i < rgb_channels.size(); i++) {
@@ -61,6 +153,32 @@ cv::Mat RTDETRProcess::preprocess(cv::Mat image){
     return blob_image;
 }
 
+/**
+ * The function preprocesses an image buffer straight into the model input blob, fusing the resize, the
+ * color conversion and the normalization into one pass (see `blob_from_image`).
+ * 
+ * @param image The view of the input image, in any of the supported pixel formats.
+ * @param blob The [3, H, W] float buffer of the model input, usually the input tensor data.
+ */
+void RTDETRProcess::preprocess(const ImageView& image, float* blob){
+    // The boxes are scaled to the source image of a downscaled view.
+    if (image.source_width > 0 && image.source_height > 0) {
+        set_image_size(image.source_height, image.source_width);
+    } else {
+        set_image_size(image.height, image.width);
+    }
+    blob_from_image(image, target_size, blob);
+}
+
+/**
+ * The function records the size of the original image, which the postprocess scales the boxes to.
+ */
+void RTDETRProcess::set_image_size(int rows, int cols){
+    im_shape = { (float)rows, (float)cols };
+    scale_factor = { (float)target_size.height / (float)rows, 
+        (float)target_size.width / (float)cols };
+}
+
 /**
  * The function `postprocess` takes in an array of scores and bounding box coordinates, and returns a
  * `ResultData` object containing the filtered results based on a threshold and post_flag.
@@ -76,43 +194,184 @@ cv::Mat RTDETRProcess::preprocess(cv::Mat image){
  * 
  * @return an object of type ResultData.
  */
-ResultData RTDETRProcess::postprocess(float* score, float* bbox, bool post_flag)
+ResultData RTDETRProcess::postprocess(const float* score, const float* bbox, bool post_flag)
 {
     ResultData result;
+    heap.clear();
     if (post_flag) {
-        for (int i = 0; i < 300; ++i) {
-            if (score[6 * i + 1] > threshold) {
-                result.clsids.push_back((int)score[6 * i ]);
-                result.labels.push_back(labels[(int)score[6 * i]]);
-                result.bboxs.push_back(cv::Rect(score[6 * i + 2], score[6 * i + 3],
-                    score[6 * i + 4] - score[6 * i + 2],
-                    score[6 * i + 5] - score[6 * i + 3]));
-                result.scores.push_back(score[6 * i + 1]);
-            }
-        }
+        decode_rows(score, result);
     } else {
-        for (int i = 0; i < 300; ++i) {
-            float s[80];
-            for (int j = 0; j < 80; ++j) {
-                s[j] = score[80 * i + j];
+        (this->*decode_fn)(score, bbox, result);
+    }
+    if (nms.get_config().method != NmsMethod::NONE) {
+        // The candidates kept by the filter go through the NMS stage, which applies the top-k limit
+        // itself and returns the kept boxes in descending score order.
+        candidates.clear();
+        candidates.reserve(heap.size());
+        for (const Candidate& c : heap) {
+            float x1, y1, x2, y2;
+            if (post_flag) {
+                const float* row = score + 6 * c.index;
+                x1 = row[2]; y1 = row[3]; x2 = row[4]; y2 = row[5];
+                candidates.push_back(x1, y1, x2, y2, c.score, c.clsid, c.index);
+            } else {
+                query_box(bbox, c.index, x1, y1, x2, y2);
+                candidates.push_back(x1, y1, x2, y2, sigmoid<float>(c.score), c.clsid, c.index);
             }
-            int clsid = argmax<float>(s, 80);
-            float max_score = sigmoid<float>(s[clsid]);
-            if (max_score > threshold) {
-                result.clsids.push_back(clsid);
-                result.labels.push_back(labels[clsid]);
-                float cx = bbox[4 * i] * 640.0 / scale_factor[1];
-                float cy = bbox[4 * i + 1] * 640.0 / scale_factor[0];
-                float w = bbox[4 * i + 2] * 640.0 / scale_factor[1];
-                float h = bbox[4 * i + 3] * 640.0 / scale_factor[0];
-                result.bboxs.push_back(cv::Rect((int)(cx - w / 2), (int)(cy - h / 2), w, h));
-                result.scores.push_back(max_score);
+        }
+        nms.run(candidates);
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            int clsid = candidates.clsids[i];
+            result.clsids.push_back(clsid);
+            result.labels.push_back(get_label(clsid));
+            result.bboxs.push_back(cv::Rect(candidates.x1[i], candidates.y1[i],
+                candidates.x2[i] - candidates.x1[i], candidates.y2[i] - candidates.y1[i]));
+            result.scores.push_back(candidates.scores[i]);
+        }
+    } else if (filter.max_detections > 0) {
+        // Sorting the heap with the min-heap comparator orders the detections by descending score.
+        std::sort_heap(heap.begin(), heap.end(), std::greater<Candidate>());
+        for (const Candidate& c : heap) {
+            if (post_flag) {
+                append_row(result, score + 6 * c.index);
+            } else {
+                append_query(result, bbox, c.index, c.clsid, c.score);
             }
         }
     }
     return result;
 }
 
+/**
+ * The function `decode_rows` decodes the [M,6] output of the post-processed model, each row is
+ * [class id, score, x1, y1, x2, y2] in original image coordinates.
+ * 
+ * @param rows A pointer to the [num_queries, 6] result rows.
+ * @param result The ResultData object the kept rows are appended to, if there is no top-k limit.
+ */
+void RTDETRProcess::decode_rows(const float* rows, ResultData& result) {
+    for (int i = 0; i < num_queries; ++i) {
+        const float* row = rows + 6 * i;
+        int clsid = (int)row[0];
+        float t = clsid >= 0 && clsid < (int)score_thresholds.size() ? score_thresholds[clsid] : default_threshold;
+        if (row[1] > t && !push_candidate(row[1], i, clsid)) {
+            append_row(result, row);
+        }
+    }
+}
+
+/**
+ * The function `decode_queries` decodes the outputs of the raw head model: every query is classified by
+ * its highest scoring class, and kept if that class passes its threshold (a dropped class has an
+ * infinite one). The boxes are normalized [cx, cy, w, h] and are
+ * scaled back to the original image.
+ * 
+ * @tparam NC The number of classes, known at compile time, or 0 to use `num_classes`.
+ * @param score A pointer to the [num_queries, num_classes] class logits.
+ * @param bbox A pointer to the [num_queries, 4] boxes.
+ * @param result The ResultData object the kept queries are appended to, if there is no top-k limit.
+ */
+template<int NC>
+void RTDETRProcess::decode_queries(const float* score, const float* bbox, ResultData& result) {
+    const int nc = NC > 0 ? NC : num_classes;
+    const float* t = logit_thresholds.data();
+    for (int i = 0; i < num_queries; ++i) {
+        const float* s = score + (size_t)nc * i;
+        int clsid = 0;
+        float max_logit = s[0];
+        for (int j = 1; j < nc; ++j) {
+            if (s[j] > max_logit) {
+                max_logit = s[j];
+                clsid = j;
+            }
+        }
+        // A query whose top class is filtered out is dropped, not demoted to its next best class.
+        if (max_logit > t[clsid] && !push_candidate(max_logit, i, clsid)) {
+            append_query(result, bbox, i, clsid, max_logit);
+        }
+    }
+}
+
+/**
+ * The function `push_candidate` offers a detection to the fixed-size top-k heap. The heap is a
+ * min-heap on the score, so a new detection only replaces the lowest scoring one once it is full.
+ * With the NMS stage enabled, every detection is collected, since a suppressed box frees its place.
+ * 
+ * @return false if there is no top-k limit and the detection has to be appended directly.
+ */
+bool RTDETRProcess::push_candidate(float score, int index, int clsid) {
+    Candidate candidate = { score, index, clsid };
+    if (nms.get_config().method != NmsMethod::NONE) {
+        heap.push_back(candidate);
+        return true;
+    }
+    const int k = filter.max_detections;
+    if (k <= 0) {
+        return false;
+    }
+    if ((int)heap.size() < k) {
+        heap.push_back(candidate);
+        std::push_heap(heap.begin(), heap.end(), std::greater<Candidate>());
+    } else if (score > heap.front().score) {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<Candidate>());
+        heap.back() = candidate;
+        std::push_heap(heap.begin(), heap.end(), std::greater<Candidate>());
+    }
+    return true;
+}
+
+/**
+ * The function `append_query` appends a query of the raw head model to the results, scaling its
+ * normalized [cx, cy, w, h] box back to the original image.
+ */
+void RTDETRProcess::append_query(ResultData& result, const float* bbox, int index, int clsid, float logit) {
+    float x1, y1, x2, y2;
+    query_box(bbox, index, x1, y1, x2, y2);
+    result.clsids.push_back(clsid);
+    result.labels.push_back(get_label(clsid));
+    result.bboxs.push_back(cv::Rect(x1, y1, x2 - x1, y2 - y1));
+    result.scores.push_back(sigmoid<float>(logit));
+}
+
+/**
+ * The function `query_box` scales the normalized [cx, cy, w, h] box of a query back to the original
+ * image, as [x1, y1, x2, y2].
+ */
+void RTDETRProcess::query_box(const float* bbox, int index, float& x1, float& y1, float& x2, float& y2) {
+    const float* b = bbox + 4 * index;
+    float cx = b[0] * im_shape[1];
+    float cy = b[1] * im_shape[0];
+    float w = b[2] * im_shape[1];
+    float h = b[3] * im_shape[0];
+    x1 = cx - w / 2;
+    y1 = cy - h / 2;
+    x2 = x1 + w;
+    y2 = y1 + h;
+}
+
+/**
+ * The function `append_row` appends a [class id, score, x1, y1, x2, y2] row of the post-processed
+ * model to the results.
+ */
+void RTDETRProcess::append_row(ResultData& result, const float* row) {
+    result.clsids.push_back((int)row[0]);
+    result.labels.push_back(get_label((int)row[0]));
+    result.bboxs.push_back(cv::Rect(row[2], row[3], row[4] - row[2], row[5] - row[3]));
+    result.scores.push_back(row[1]);
+}
+
+/**
+ * The function returns the label of a class, or the class id if the label table has no entry for it.
+ * 
+ * @param clsid The class id.
+ */
+std::string RTDETRProcess::get_label(int clsid) {
+    if (labels) {
+        return labels->get(clsid);
+    }
+    return std::to_string(clsid);
+}
+
 
 /**
  * The function `draw_box` takes an input image and a set of results, and draws bounding boxes with
@@ -161,23 +420,22 @@ cv::Mat RTDETRProcess::draw_box(cv::Mat image, ResultData results) {
 }
 
 /**
- * The function reads labels from a file and stores them in a vector.
+ * The function reads labels from a file into a label table.
  * 
  * @param label_path The parameter `label_path` is a string that represents the path to the file
- * containing the labels.
+ * containing the labels. A std::runtime_error is thrown if the file cannot be read.
  */
 void RTDETRProcess::read_labels(std::string label_path){
-    std::ifstream file(label_path);
-    if (file){
-        std::string str;
-        while (std::getline(file, str)) {
-            labels.push_back(str);
-        }
-    }
-    else {
-        std::cout << "Open file faild." << std::endl;
-    }
-    file.close();
+    labels = std::make_shared<LabelTable>(LabelTable::load(label_path));
+}
+
+/**
+ * The function `set_labels` shares a label table already loaded, e.g. by the predictor for all its
+ * requests.
+ */
+void RTDETRProcess::set_labels(std::shared_ptr<const LabelTable> labels){
+    this->labels = labels;
+    update_thresholds();
 }
 
 
@@ -14,10 +14,15 @@
 #define __PROCESS_H__
 
 #include <algorithm>
+#include <cmath>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "opencv2/opencv.hpp"
+#include "nms.h"
+#include "image_input.h"
+#include "label_table.h"
 
 #define INFO(...) \
         std::cout << "[INFO]  " << __VA_ARGS__ << std::endl;
@@ -32,36 +37,78 @@ struct ResultData {
 };
 
 
+// The detection filter, evaluated inside the decode pass of `RTDETRProcess::postprocess`.
+struct FilterConfig {
+    float threshold;                        // The score threshold of the classes without an own threshold.
+    std::vector<float> class_thresholds;    // The per-class thresholds, indexed by class id.
+    std::vector<int> allowed_classes;       // The classes to keep, empty to keep every class.
+    int max_detections;                     // The top-k limit on the number of detections, 0 for no limit.
+    FilterConfig() : threshold(0.5f), max_detections(0) {}
+};
+
+
 class RTDETRProcess
 {
 public:
-    RTDETRProcess() {}
-    RTDETRProcess(cv::Size target_size, std::string label_path = NULL, float threshold = 0.5,
+    RTDETRProcess() : interpf(cv::INTER_LINEAR), num_classes(0) { set_output_dims(300, 80); }
+    RTDETRProcess(cv::Size target_size, std::string label_path = "", float threshold = 0.5,
         cv::InterpolationFlags interpf = cv::INTER_LINEAR);
+    void set_output_dims(int num_queries, int num_classes);
+    void set_labels(std::shared_ptr<const LabelTable> labels);
+    std::shared_ptr<const LabelTable> get_labels() { return labels; }
+    void set_filter(const FilterConfig& filter);
+    FilterConfig get_filter() { return filter; }
+    int get_num_queries() { return num_queries; }
+    void set_nms(const NmsConfig& config);
     cv::Mat preprocess(cv::Mat image);
-    ResultData postprocess(float* score, float* bboxs, bool post_flag);
+    void preprocess(const ImageView& image, float* blob);
+    ResultData postprocess(const float* score, const float* bboxs, bool post_flag);
     std::vector<float> get_im_shape() { return im_shape; }
-    std::vector<float> get_input_shape() { return { (float)target_size.width ,(float)target_size.height }; }
+    std::vector<float> get_input_shape() { return { (float)target_size.height ,(float)target_size.width }; }
+    cv::Size get_target_size() { return target_size; }
+    void set_target_size(cv::Size size) { target_size = size; }
     std::vector<float> get_scale_factor() { return scale_factor; }
     cv::Mat draw_box(cv::Mat image, ResultData results);
 
 private:
     void read_labels(std::string label_path);
+    void set_image_size(int rows, int cols);
     template<class T>
     float sigmoid(T data) {
         return 1.0f / (1 + std::exp(-data));
     }
-    template<class T>
-    int argmax(T* data, int length) {
-        std::vector<T> arr(data, data + length);
-        return (int)(std::max_element(arr.begin(), arr.end()) - arr.begin());
-    }
+    template<int NC>
+    void decode_queries(const float* score, const float* bbox, ResultData& result);
+    void decode_rows(const float* rows, ResultData& result);
+    void update_thresholds();
+    bool push_candidate(float score, int index, int clsid);
+    void append_query(ResultData& result, const float* bbox, int index, int clsid, float logit);
+    void append_row(ResultData& result, const float* row);
+    void query_box(const float* bbox, int index, float& x1, float& y1, float& x2, float& y2);
+    std::string get_label(int clsid);
+
+    // A detection kept by the filter, waiting in the top-k heap.
+    struct Candidate {
+        float score;
+        int index;
+        int clsid;
+        bool operator>(const Candidate& other) const { return score > other.score; }
+    };
 
 private:
     cv::Size target_size;               // The model input size.
-    std::vector<std::string> labels;    // The model classification label.
-    float threshold;                    // The threshold parameter.
+    std::shared_ptr<const LabelTable> labels;   // The model classification label, shared by the copies.
+    FilterConfig filter;                // The threshold, class and top-k filter.
     cv::InterpolationFlags interpf;     // The image scaling method.
+    std::vector<float> score_thresholds;    // The per-class thresholds, +inf for dropped classes.
+    std::vector<float> logit_thresholds;    // The per-class thresholds before the sigmoid.
+    float default_threshold;            // The threshold of the classes beyond `score_thresholds`.
+    std::vector<Candidate> heap;        // The top-k min-heap, reused across frames.
+    BoxSuppressor nms;                  // The optional NMS stage.
+    BoxSet candidates;                  // The NMS input and output, reused across frames.
+    int num_queries;                    // The number of decoder queries.
+    int num_classes;                    // The number of classes of the score output.
+    void (RTDETRProcess::*decode_fn)(const float*, const float*, ResultData&);
     std::vector<float> im_shape;
     std::vector<float> scale_factor;
 };
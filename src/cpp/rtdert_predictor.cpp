@@ -10,10 +10,26 @@
 // @Description : 
 
 #include "rtdert_predictor.h"
+#include <stdexcept>
 #include <opencv2/opencv.hpp>
 #include "process.h"
+#include "image_decoder.h"
+#include "mapped_file.h"
+#include "memory_usage.h"
 
 
+/**
+ * The function returns the file holding the weights of a model: the .bin next to an IR .xml, or the
+ * model file itself (ONNX).
+ */
+static std::string weight_path(const std::string& model_path) {
+    size_t dot = model_path.find_last_of('.');
+    if (dot != std::string::npos && model_path.substr(dot) == ".xml") {
+        return model_path.substr(0, dot) + ".bin";
+    }
+    return model_path;
+}
+
 /**
  * The RTDETRPredictor constructor initializes the RTDETRPredictor object with the specified model
  * path, label path, device name, and post_flag.
@@ -29,76 +45,657 @@
  * the inference model includes a network layer for post-processing the inference results. If 'post_flag'
  * is set to False, the inference model does not include a network layer for post-processing the inference 
  * results. Default value is True.
+ * @param options The size of the infer request pool used by `detect_batch`, the input size of
+ * the reduced resolution variant used by the deadline-aware `detect`, the CPU thread budget, and the
+ * bound of a dynamic image input.
  */
 RTDETRPredictor::RTDETRPredictor(std::string model_path, std::string label_path, 
-std::string device_name, bool post_flag)
-	:post_flag(post_flag){
-    INFO("Model path: " + model_path);
+std::string device_name, bool post_flag, const PredictorOptions& options)
+    :RTDETRPredictor(ModelBundle::from_paths(model_path, label_path, post_flag), device_name, options){
+}
+
+/**
+ * The RTDETRPredictor constructor loads a model bundle, see `load_bundle`. The labels are loaded once
+ * for all requests and checked against the class count at startup, so that a wrong label file fails
+ * here rather than showing up as wrong names in the results.
+ * 
+ * @param bundle The ModelBundle object describing the model, its labels and its processing.
+ * @param device_name The device name, e.g. "CPU" or "GPU.0".
+ * @param options The request pool, deadline, thread, input shape and memory options. A `max_input_size`
+ * set here takes precedence over the one of the bundle.
+ */
+RTDETRPredictor::RTDETRPredictor(const ModelBundle& bundle, std::string device_name,
+    const PredictorOptions& options)
+	:post_flag(bundle.post_flag){
+    INFO("Model path: " + bundle.model_path);
     INFO("Device name: " + device_name);
+    std::memset(&memory_stats, 0, sizeof(memory_stats));
+    std::memset(&warmup_stats, 0, sizeof(warmup_stats));
+    // Paging the weights in before the model is read keeps the page faults out of read_model and
+    // compile_model as well as out of the first requests.
+    if (options.prefault_weights) {
+        auto t1 = std::chrono::steady_clock::now();
+        warmup_stats.prefault_bytes = MappedFile(weight_path(bundle.model_path)).prefault();
+        warmup_stats.prefault_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - t1).count();
+    }
+    // A mapped weight file is paged in on demand and shared with the page cache, instead of being
+    // copied into the heap.
+    core.set_property(ov::enable_mmap(options.mmap_weights));
+    int64_t mark = (int64_t)current_rss();
 	// The `read_model` function reads the model file and returns a shared pointer to an
     // instance of the `ov::Model` class, which represents the model. 
-    model = core.read_model(model_path);
+    model = core.read_model(bundle.model_path);
+    memory_stats.model_rss = (int64_t)current_rss() - mark;
+    memory_stats.weight_bytes = model_weight_bytes(model);
     pritf_model_info(model);
-	// The line is compiling the model for a specific device. 
-    compiled_model = core.compile_model(model, device_name);
-	// Creates an inference request object for the compiled model. This request object is
+    // Resolving the input and output roles and dimensions: the names given by the bundle first, the
+    // rest from the model shapes.
+    model_info = read_bundle_model_info(model, bundle);
+    INFO("  Input size: " + std::to_string(model_info.input_size.width) + "x" +
+        std::to_string(model_info.input_size.height) + ", queries: " + std::to_string(model_info.num_queries) +
+        ", classes: " + std::to_string(model_info.num_classes));
+    std::shared_ptr<const LabelTable> labels = load_labels(bundle);
+    // The input shapes are fixed once here, so that no inference has to reshape or re-plan.
+    cv::Size max_input_size = options.max_input_size.area() > 0 ? options.max_input_size : bundle.max_input_size;
+    if (reshape_inputs(model, model_info, max_input_size)) {
+        INFO("  Reshaped inputs: " + model->input(0).get_partial_shape().to_string() +
+            (model_info.dynamic_input ? " (dynamic image size)" : ""));
+    }
+	// The line is compiling the model for a specific device. With a request pool the device is
+    // asked for throughput, so that the pooled requests run on parallel streams.
+    int num_requests = std::max(options.num_requests, 1);
+    if (options.max_requests > 0) {
+        num_requests = std::min(num_requests, options.max_requests);
+    }
+    ov::AnyMap config;
+    if (num_requests > 1) {
+        config.insert(ov::hint::performance_mode(ov::hint::PerformanceMode::THROUGHPUT));
+        config.insert(ov::hint::num_requests((uint32_t)num_requests));
+    }
+    // A lower inference precision halves the compiled weights and the intermediate buffers, the
+    // device falls back to its default where it does not support the type.
+    if (options.inference_precision != ov::element::undefined) {
+        config.insert(ov::hint::inference_precision(options.inference_precision));
+        INFO("  Inference precision: " + options.inference_precision.get_type_name());
+    }
+    // A CPU thread budget splits the cores between the preprocess and the inference streams,
+    // instead of letting both pools claim every core.
+    bool budget_flag = options.cpu_threads > 0 && device_name.find("CPU") != std::string::npos;
+    if (budget_flag) {
+        thread_budget = plan_thread_budget(options.cpu_threads, num_requests);
+        add_infer_budget(thread_budget, config);
+        INFO("  CPU threads: " + std::to_string(thread_budget.host_threads) + " preprocess, " +
+            std::to_string(thread_budget.infer_threads) + " inference in " +
+            std::to_string(thread_budget.streams) + " streams");
+    }
+    mark = (int64_t)current_rss();
+    compiled_model = core.compile_model(model, device_name, config);
+    memory_stats.compile_rss = (int64_t)current_rss() - mark;
+    // Creating an instance of the `RTDETRProcess` class for the image of every request.
+    RTDETRProcess process(model_info.input_size, "", bundle.filter.threshold);
+    process.set_labels(labels);
+    process.set_filter(bundle.filter);
+    process.set_nms(bundle.nms);
+    if (!post_flag) {
+        process.set_output_dims(model_info.num_queries, model_info.num_classes);
+    }
+	// Creates the inference request objects for the compiled model. A request object is
     // used to perform inference on the model by providing input data and retrieving the output data.
-    infer_request = compiled_model.create_infer_request();
-    // Creating an instance of the `RTDETRProcess` class and assigning it to the `rtdetr_process` variable.
-    rtdetr_process = RTDETRProcess(cv::Size(640, 640), label_path, 0.5);
+    mark = (int64_t)current_rss();
+    slots.resize(num_requests);
+    for (InferSlot& slot : slots) {
+        init_slot(slot, compiled_model, process, model_info.dynamic_input);
+    }
+    memory_stats.requests_rss = (int64_t)current_rss() - mark;
+    // The reduced resolution variant is the same model reshaped to a smaller image input, the
+    // decoder output does not depend on the input size.
+    if (options.fallback_size.area() > 0) {
+        INFO("  Fallback input size: " + std::to_string(options.fallback_size.width) + "x" +
+            std::to_string(options.fallback_size.height));
+        std::shared_ptr<ov::Model> small_model = model->clone();
+        std::map<std::string, ov::PartialShape> shapes;
+        shapes[model_info.image_input] = ov::PartialShape{ 1, 3, options.fallback_size.height,
+            options.fallback_size.width };
+        small_model->reshape(shapes);
+        mark = (int64_t)current_rss();
+        fallback_model = core.compile_model(small_model, device_name, config);
+        memory_stats.compile_rss += (int64_t)current_rss() - mark;
+        fallback_slots.resize(1);
+        RTDETRProcess small_process = process;
+        small_process.set_target_size(options.fallback_size);
+        init_slot(fallback_slots[0], fallback_model, small_process, false);
+    }
+    // The compiled models hold their own copy of the graph, the source model is only needed for the
+    // variants above.
+    if (options.release_model) {
+        mark = (int64_t)current_rss();
+        model.reset();
+        trim_heap();
+        memory_stats.released_rss = mark - (int64_t)current_rss();
+    }
+    // The host pool is sized after compiling, so that the threads of the device plugin do not
+    // start out pinned to the preprocess cores.
+    if (budget_flag) {
+        apply_host_budget(thread_budget, options.pin_threads);
+    }
+    std::memset(&deadline_stats, 0, sizeof(deadline_stats));
+    pipeline_index = 0;
+    pipeline_pending = false;
+    // Running every request once here keeps the lazy device setup and the kernel selection out of
+    // the first real requests.
+    if (options.warmup_iterations > 0) {
+        mark = (int64_t)current_rss();
+        warm_up(options.warmup_iterations);
+        memory_stats.warmup_rss = (int64_t)current_rss() - mark;
+        INFO("  Warm-up: first inference " << warmup_stats.first_ms << " ms, steady " <<
+            warmup_stats.steady_ms << " ms");
+    }
+    // The double-buffered pair is otherwise created, and warmed up, on the first frame of a stream.
+    if (options.pipelined) {
+        init_pipeline();
+    }
+    count_buffer_bytes();
+    INFO("  Memory: " << current_rss() / (1024 * 1024) << " MB resident, " <<
+        memory_stats.weight_bytes / (1024 * 1024) << " MB weights, " <<
+        memory_stats.tensor_bytes / (1024 * 1024) << " MB tensors");
+}
+
+/**
+ * The function returns the options of a predictor for a memory-constrained device: one infer request
+ * (one inference stream and one set of intermediate buffers) and the source model released after
+ * compiling. The weights stay mapped rather than copied, as by default. A fallback variant would
+ * compile the model a second time, so none is set.
+ *
+ * @param precision The inference precision hint, e.g. ov::element::f16 on GPU and ARM or
+ * ov::element::bf16 on CPUs with AVX512-BF16/AMX; undefined keeps the device default.
+ */
+PredictorOptions PredictorOptions::low_memory(ov::element::Type precision){
+    PredictorOptions options;
+    options.num_requests = 1;
+    options.max_requests = 1;
+    options.release_model = true;
+    options.inference_precision = precision;
+    return options;
+}
+
+/**
+ * The function `get_memory_stats` reports the memory of the predictor: the weight size of the source
+ * model, the RSS each loading step added, the bytes of the request tensors and host buffers (as of the
+ * warm-up, or of the double-buffered mode once started), and the RSS of the process now.
+ */
+MemoryStats RTDETRPredictor::get_memory_stats(){
+    MemoryStats stats = memory_stats;
+    stats.rss = current_rss();
+    stats.peak_rss = peak_rss();
+    return stats;
+}
+
+/**
+ * The function counts the bytes of the input and output tensors of all requests, and of the buffers
+ * the predictor owns besides: the preallocated images of a dynamic input and the label table. The
+ * count is kept rather than taken in `get_memory_stats`, where a request might be running.
+ */
+void RTDETRPredictor::count_buffer_bytes(){
+    memory_stats.tensor_bytes = 0;
+    memory_stats.host_bytes = 0;
+    for (std::vector<InferSlot>* group : { &slots, &fallback_slots, &pipeline_slots }) {
+        for (InferSlot& slot : *group) {
+            for (size_t i = 0; i < slot.request.get_compiled_model().inputs().size(); ++i) {
+                memory_stats.tensor_bytes += slot.request.get_input_tensor(i).get_byte_size();
+            }
+            for (size_t i = 0; i < slot.request.get_compiled_model().outputs().size(); ++i) {
+                memory_stats.tensor_bytes += slot.request.get_output_tensor(i).get_byte_size();
+            }
+            if (slot.dynamic_input) {
+                memory_stats.host_bytes += slot.image_tensor.get_byte_size();
+            }
+        }
+    }
+    if (slots[0].process.get_labels()) {
+        memory_stats.host_bytes += slots[0].process.get_labels()->get_bytes();
+    }
+}
+
+/**
+ * The function loads the label table of a bundle and checks it against the class count of the raw
+ * head output, or the `num_classes` of the bundle for a post-processed model whose result rows do not
+ * reveal it.
+ * 
+ * @return the LabelTable object, nullptr if the bundle has no labels. A std::runtime_error is thrown
+ * if the file cannot be read or its label count does not match.
+ */
+std::shared_ptr<const LabelTable> RTDETRPredictor::load_labels(const ModelBundle& bundle){
+    if (bundle.num_classes > 0 && model_info.num_classes > 0 && bundle.num_classes != model_info.num_classes) {
+        throw std::runtime_error("The bundle expects " + std::to_string(bundle.num_classes) +
+            " classes, the model has " + std::to_string(model_info.num_classes) + ".");
+    }
+    if (bundle.label_path.empty()) {
+        return nullptr;
+    }
+    std::shared_ptr<const LabelTable> labels = std::make_shared<LabelTable>(LabelTable::load(bundle.label_path));
+    int classes = model_info.num_classes > 0 ? model_info.num_classes : bundle.num_classes;
+    if (labels->empty() || (classes > 0 && labels->size() != classes)) {
+        throw std::runtime_error("The label file " + bundle.label_path + " has " +
+            std::to_string(labels->size()) + " labels, the model has " + std::to_string(classes) + " classes.");
+    }
+    INFO("  Labels: " + std::to_string(labels->size()));
+    return labels;
 }
 
 /**
- * The `predict` function takes an input image, preprocesses it, performs inference using a pre-trained
- * model, postprocesses the output, and returns the image with bounding boxes drawn around detected
- * objects.
+ * The function `warm_up` runs every pooled request (the reduced resolution variant and the
+ * double-buffered pair included) on a blank image, `iterations` times. The steady latencies seed the
+ * cost estimates of the deadline-aware `detect`.
+ * 
+ * @param iterations The rounds over the pool, 2 or more to see the first against the steady latency.
+ * 
+ * @return the WarmupStats object, also kept for `get_warmup_stats`.
+ */
+WarmupStats RTDETRPredictor::warm_up(int iterations){
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+    cv::Mat blank(model_info.input_size, CV_8UC3, cv::Scalar(114, 114, 114));
+    ImageView view = ImageView::from_mat(blank);
+    std::vector<InferSlot*> pool;
+    for (std::vector<InferSlot>* group : { &slots, &fallback_slots, &pipeline_slots }) {
+        for (InferSlot& slot : *group) {
+            pool.push_back(&slot);
+        }
+    }
+    warmup_stats.iterations = iterations;
+    for (int i = 0; i < iterations; ++i) {
+        for (InferSlot* slot : pool) {
+            Clock::time_point t1 = Clock::now();
+            fill_inputs(*slot, view);
+            slot->request.infer();
+            read_outputs(*slot);
+            double ms = std::chrono::duration<double, std::milli>(Clock::now() - t1).count();
+            if (slot == &slots[0]) {
+                warmup_stats.first_ms = i == 0 ? ms : warmup_stats.first_ms;
+                warmup_stats.steady_ms = ms;
+                deadline_stats.primary_cost_ms = ms;
+            } else if (!fallback_slots.empty() && slot == &fallback_slots[0]) {
+                deadline_stats.fallback_cost_ms = ms;
+            }
+        }
+    }
+    warmup_stats.warmup_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    return warmup_stats;
+}
+
+/**
+ * The `predict` function takes an input image, detects the objects in it, and returns the image with
+ * bounding boxes drawn around detected objects.
  * 
  * @param image The input image that needs to be processed and predicted by the RTDETR model.
  * 
  * @return a cv::Mat object, which represents an image.
  */
 cv::Mat RTDETRPredictor::predict(cv::Mat image){
-    cv::Mat blob_image = rtdetr_process.preprocess(image);
-    if (post_flag) {
-        ov::Tensor image_tensor = infer_request.get_tensor("image");
-        ov::Tensor shape_tensor = infer_request.get_tensor("im_shape");
-        ov::Tensor scale_tensor = infer_request.get_tensor("scale_factor");
-        image_tensor.set_shape({ 1,3,640,640 });
-        shape_tensor.set_shape({ 1,2 });
-        scale_tensor.set_shape({ 1,2 });
-        fill_tensor_data_image(image_tensor, blob_image);
-        fill_tensor_data_float(shape_tensor, rtdetr_process.get_input_shape().data(), 2);
-        fill_tensor_data_float(scale_tensor, rtdetr_process.get_scale_factor().data(), 2);
-    } else {
-        ov::Tensor image_tensor = infer_request.get_input_tensor();
-        image_tensor.set_shape({ 1,3,640,640 });
-        fill_tensor_data_image(image_tensor, blob_image);
+    return slots[0].process.draw_box(image, detect(image));
+}
+
+/**
+ * The deadline-aware `predict` detects the objects with `detect(image, deadline)`, and only draws the
+ * boxes if the drawing is expected to finish before the deadline; when behind, the input image is
+ * returned as is, so a real-time consumer can show it without waiting.
+ * 
+ * @param image The input image.
+ * @param deadline The time the rendered frame is due.
+ * 
+ * @return the image with the boxes, or the input image if the frame was skipped, cancelled or the
+ * rendering would miss the deadline.
+ */
+cv::Mat RTDETRPredictor::predict(cv::Mat image, std::chrono::steady_clock::time_point deadline){
+    typedef std::chrono::steady_clock Clock;
+    DeadlineResult detection = detect(ImageView::from_mat(image), deadline);
+    if (detection.status != DeadlineStatus::COMPLETED) {
+        return image;
     }
-    infer_request.infer();
-    ResultData results;
-    if (post_flag) {
-        ov::Tensor output_tensor = infer_request.get_output_tensor(0);
-        float result[6 * 300] = {0};
-        for (int i = 0; i < 6 * 300; ++i) {
-            result[i] = output_tensor.data<float>()[i];
+    Clock::time_point start = Clock::now();
+    if (start + std::chrono::microseconds((int64_t)(deadline_stats.render_cost_ms * 1000)) > deadline) {
+        ++deadline_stats.render_skipped;
+        return image;
+    }
+    cv::Mat rendered = slots[0].process.draw_box(image, detection.result);
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    deadline_stats.render_cost_ms += 0.2 * (ms - deadline_stats.render_cost_ms);
+    return rendered;
+}
+
+/**
+ * The `detect` function takes an input image, preprocesses it, performs inference using a pre-trained
+ * model, and postprocesses the output with the detection filter set by `set_filter`.
+ * 
+ * @param image The input image that needs to be processed and predicted by the RTDETR model.
+ * 
+ * @return a ResultData object with the detected objects.
+ */
+ResultData RTDETRPredictor::detect(cv::Mat image){
+    return detect(ImageView::from_mat(image));
+}
+
+/**
+ * The `detect` function takes a caller-owned image buffer (packed BGR/RGB/GRAY or planar NV12/I420),
+ * converts it straight into the input tensor in one fused pass, performs inference, and postprocesses
+ * the output with the detection filter set by `set_filter`. No cv::Mat is created for the input.
+ * 
+ * @param image The view of the input image, the buffer only has to stay valid during the call.
+ * 
+ * @return a ResultData object with the detected objects.
+ */
+ResultData RTDETRPredictor::detect(const ImageView& image){
+    fill_inputs(slots[0], image);
+    slots[0].request.infer();
+    return read_outputs(slots[0]);
+}
+
+/**
+ * The `detect_encoded` function detects the objects in an encoded image (JPEG, PNG, ...). A large JPEG
+ * is decoded near the model input size by the DCT-scaled decoder, the detections are still reported
+ * in the size of the encoded image.
+ * 
+ * @param data, size The encoded image.
+ * 
+ * @return a ResultData object with the detected objects.
+ */
+ResultData RTDETRPredictor::detect_encoded(const uint8_t* data, size_t size){
+    DecodedImage image;
+    decode_image(data, size, model_info.input_size, image);
+    return detect(image.view());
+}
+
+/**
+ * The deadline-aware `detect` fits the inference of a frame into a time budget:
+ * - a frame that cannot finish in time by the running latency estimate is skipped without inference
+ *   (a stale frame), unless the reduced resolution variant can still make it, then that one is used;
+ * - a started inference that is still running at the deadline is cancelled with
+ *   `InferRequest::cancel`, so the request is free for the next frame;
+ * - the outcome is counted in `get_deadline_stats`.
+ * The estimate of a variant that is being avoided decays slowly, so it is retried once the load drops.
+ * 
+ * @param image The view of the input image.
+ * @param deadline The time the detections are due.
+ * 
+ * @return the status, the detections if completed, and whether they met the deadline.
+ */
+DeadlineResult RTDETRPredictor::detect(const ImageView& image, std::chrono::steady_clock::time_point deadline){
+    typedef std::chrono::steady_clock Clock;
+    DeadlineResult out;
+    out.status = DeadlineStatus::SKIPPED;
+    out.met = false;
+    out.used_fallback = false;
+    out.latency_ms = 0.0;
+    ++deadline_stats.frames;
+    Clock::time_point start = Clock::now();
+    double budget = std::chrono::duration<double, std::milli>(deadline - start).count();
+    InferSlot* slot = &slots[0];
+    double* cost = &deadline_stats.primary_cost_ms;
+    if (budget < deadline_stats.primary_cost_ms) {
+        deadline_stats.primary_cost_ms *= 0.98;
+        if (fallback_slots.empty() || budget < deadline_stats.fallback_cost_ms) {
+            deadline_stats.fallback_cost_ms *= 0.98;
+            ++deadline_stats.skipped;
+            ++deadline_stats.missed;
+            return out;
         }
-        results = rtdetr_process.postprocess(result, nullptr, true);
-    } else {
-        ov::Tensor score_tensor = infer_request.get_tensor(model->outputs()[1].get_any_name());
-        ov::Tensor bbox_tensor = infer_request.get_tensor(model->outputs()[0].get_any_name());
-        float score[300 * 80] = {0};
-        float bbox[300 * 4] = {0};
-        for (int i = 0; i < 300; ++i) {
-            for (int j = 0; j < 80; ++j) {
-                score[80 * i + j] = score_tensor.data<float>()[80 * i + j];
-            }
-            for (int j = 0; j < 4; ++j) {
-                bbox[4 * i + j] = bbox_tensor.data<float>()[4 * i + j];
+        slot = &fallback_slots[0];
+        cost = &deadline_stats.fallback_cost_ms;
+        out.used_fallback = true;
+    }
+
+    fill_inputs(*slot, image);
+    slot->request.start_async();
+    // wait_for takes milliseconds: round the time left up, a request is never cancelled before its
+    // deadline (std::chrono::ceil is C++17).
+    Clock::duration left = deadline - Clock::now();
+    std::chrono::milliseconds remaining = std::chrono::duration_cast<std::chrono::milliseconds>(left);
+    if (remaining < left) {
+        remaining += std::chrono::milliseconds(1);
+    }
+    if (!slot->request.wait_for(std::max(remaining, std::chrono::milliseconds(0)))) {
+        slot->request.cancel();
+        try {
+            slot->request.wait();
+        }
+        catch (const ov::Exception&) {
+            // The request reports the cancellation, it is ready for the next frame.
+        }
+        out.status = DeadlineStatus::CANCELLED;
+        out.latency_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        // The inference took at least this long.
+        *cost = std::max(*cost, out.latency_ms);
+        ++deadline_stats.cancelled;
+        ++deadline_stats.missed;
+        return out;
+    }
+    out.result = read_outputs(*slot);
+    Clock::time_point end = Clock::now();
+    out.status = DeadlineStatus::COMPLETED;
+    out.latency_ms = std::chrono::duration<double, std::milli>(end - start).count();
+    out.met = end <= deadline;
+    *cost = *cost == 0.0 ? out.latency_ms : *cost + 0.2 * (out.latency_ms - *cost);
+    ++(out.met ? deadline_stats.met : deadline_stats.late);
+    deadline_stats.missed += out.met ? 0 : 1;
+    deadline_stats.fallback += out.used_fallback ? 1 : 0;
+    return out;
+}
+
+/**
+ * The `predict_pipelined` function is the double-buffered `predict` for a video stream: it starts the
+ * inference of `image` and returns the previous frame with its boxes drawn, which were decoded and
+ * drawn while `image` was in the engine. The output lags the input by one frame.
+ * 
+ * @param image The next frame. It is kept until the next call, so a capture loop must not write
+ * into the same buffer.
+ * 
+ * @return the previous frame with the boxes, or an empty cv::Mat for the first frame.
+ */
+cv::Mat RTDETRPredictor::predict_pipelined(cv::Mat image){
+    cv::Mat previous_image = pipeline_image;
+    pipeline_image = image;
+    ResultData previous;
+    if (!pipeline_push(ImageView::from_mat(image), previous)) {
+        return cv::Mat();
+    }
+    return slots[0].process.draw_box(previous_image, previous);
+}
+
+/**
+ * The function `pipeline_push` runs the double-buffered mode: two infer requests ping-pong, so the
+ * input of frame N+1 is filled while frame N is in the engine, and the outputs of frame N are decoded
+ * (and drawn by the caller) while frame N+1 is in the engine. The output tensors of both requests are
+ * bound to preallocated host tensors, so the results stay in place until they are decoded.
+ * 
+ * @param image The view of the next frame, it only has to stay valid during the call.
+ * @param previous Receives the detections of the frame pushed before.
+ * 
+ * @return false for the first frame, which has no previous frame.
+ */
+bool RTDETRPredictor::pipeline_push(const ImageView& image, ResultData& previous){
+    if (pipeline_slots.empty()) {
+        init_pipeline();
+    }
+    InferSlot& current = pipeline_slots[pipeline_index];
+    fill_inputs(current, image);
+    current.request.start_async();
+    pipeline_index ^= 1;
+    bool has_previous = pipeline_pending;
+    if (has_previous) {
+        InferSlot& last = pipeline_slots[pipeline_index];
+        last.request.wait();
+        previous = read_outputs(last);
+    }
+    pipeline_pending = true;
+    return has_previous;
+}
+
+/**
+ * The function `pipeline_flush` waits for the last frame pushed with `pipeline_push`, at the end of a
+ * stream.
+ * 
+ * @return false if no frame is in flight.
+ */
+bool RTDETRPredictor::pipeline_flush(ResultData& previous){
+    if (!pipeline_pending) {
+        return false;
+    }
+    InferSlot& last = pipeline_slots[pipeline_index ^ 1];
+    last.request.wait();
+    previous = read_outputs(last);
+    pipeline_pending = false;
+    pipeline_image = cv::Mat();
+    return true;
+}
+
+/**
+ * The function creates the two requests of the double-buffered mode, and binds their static shape
+ * outputs to host tensors allocated once. The dynamic result output of the post-processed model keeps
+ * the tensor of the plugin. Each request is run once on a blank image, since the pair is created
+ * after the warm-up of the constructor.
+ */
+void RTDETRPredictor::init_pipeline(){
+    pipeline_slots.resize(2);
+    for (InferSlot& slot : pipeline_slots) {
+        init_slot(slot, compiled_model, slots[0].process, model_info.dynamic_input);
+        for (size_t i = 0; i < compiled_model.outputs().size(); ++i) {
+            const ov::Output<const ov::Node> output = compiled_model.output(i);
+            if (output.get_partial_shape().is_dynamic()) {
+                continue;
             }
+            slot.request.set_output_tensor(i, ov::Tensor(output.get_element_type(), output.get_shape()));
+        }
+    }
+    cv::Mat blank(model_info.input_size, CV_8UC3, cv::Scalar(114, 114, 114));
+    ImageView view = ImageView::from_mat(blank);
+    for (InferSlot& slot : pipeline_slots) {
+        fill_inputs(slot, view);
+        slot.request.infer();
+        read_outputs(slot);
+    }
+    pipeline_index = 0;
+    pipeline_pending = false;
+    count_buffer_bytes();
+}
+
+/**
+ * The `detect_batch` function detects the objects in several images at once. Every image goes to its
+ * own request of the pool, and a request is started as soon as its input is filled, so the
+ * preprocessing of an image overlaps the inference of the previous ones. Batches larger than the pool
+ * are processed in rounds.
+ * 
+ * @param images The views of the input images, the buffers only have to stay valid during the call.
+ * 
+ * @return the ResultData objects in the order of the images.
+ */
+std::vector<ResultData> RTDETRPredictor::detect_batch(const std::vector<ImageView>& images){
+    std::vector<ResultData> results(images.size());
+    for (size_t begin = 0; begin < images.size(); begin += slots.size()) {
+        size_t end = std::min(images.size(), begin + slots.size());
+        for (size_t i = begin; i < end; ++i) {
+            fill_inputs(slots[i - begin], images[i]);
+            slots[i - begin].request.start_async();
+        }
+        for (size_t i = begin; i < end; ++i) {
+            slots[i - begin].request.wait();
+            results[i] = read_outputs(slots[i - begin]);
+        }
+    }
+    return results;
+}
+
+/**
+ * The function sets the detection filter of every request.
+ */
+void RTDETRPredictor::set_filter(const FilterConfig& filter){
+    for (std::vector<InferSlot>* pool : { &slots, &fallback_slots, &pipeline_slots }) {
+        for (InferSlot& slot : *pool) {
+            slot.process.set_filter(filter);
         }
-        results = rtdetr_process.postprocess(score, bbox, false);
     }
-    return rtdetr_process.draw_box(image, results);
+}
+
+/**
+ * The function sets the NMS stage of every request.
+ */
+void RTDETRPredictor::set_nms(const NmsConfig& config){
+    for (std::vector<InferSlot>* pool : { &slots, &fallback_slots, &pipeline_slots }) {
+        for (InferSlot& slot : *pool) {
+            slot.process.set_nms(config);
+        }
+    }
+}
+
+/**
+ * The function creates the request of a slot and its image input. A static input uses the tensor of
+ * the plugin as is. A dynamic input gets a host tensor of the largest input size, of which every frame
+ * binds a view with its own shape.
+ */
+void RTDETRPredictor::init_slot(InferSlot& slot, ov::CompiledModel& compiled, const RTDETRProcess& process,
+    bool dynamic_input){
+    slot.request = compiled.create_infer_request();
+    slot.process = process;
+    slot.dynamic_input = dynamic_input;
+    if (dynamic_input) {
+        slot.image_tensor = ov::Tensor(ov::element::f32, { 1, 3, (size_t)model_info.input_size.height,
+            (size_t)model_info.input_size.width });
+        slot.bound_size = cv::Size();
+    } else {
+        slot.image_tensor = slot.request.get_tensor(model_info.image_input);
+        slot.bound_size = slot.process.get_target_size();
+    }
+}
+
+/**
+ * The function converts an image straight into the input tensors of a request in one fused pass. The
+ * image input is only rebound when the input size of a dynamic slot changes, and then to a view of
+ * the preallocated tensor, so nothing is reallocated per frame.
+ */
+void RTDETRPredictor::fill_inputs(InferSlot& slot, const ImageView& image){
+    cv::Size size = slot.process.get_target_size();
+    if (slot.dynamic_input) {
+        size = dynamic_input_size(image.width, image.height, model_info.input_size);
+        slot.process.set_target_size(size);
+    }
+    if (size != slot.bound_size) {
+        slot.request.set_tensor(model_info.image_input, ov::Tensor(ov::element::f32,
+            { 1, 3, (size_t)size.height, (size_t)size.width }, slot.image_tensor.data<float>()));
+        slot.bound_size = size;
+    }
+    slot.process.preprocess(image, slot.image_tensor.data<float>());
+    if (post_flag) {
+        ov::Tensor shape_tensor = slot.request.get_tensor(model_info.shape_input);
+        ov::Tensor scale_tensor = slot.request.get_tensor(model_info.scale_input);
+        fill_tensor_data_float(shape_tensor, slot.process.get_input_shape().data(), 2);
+        fill_tensor_data_float(scale_tensor, slot.process.get_scale_factor().data(), 2);
+    }
+}
+
+/**
+ * The function decodes the output tensors of a finished request in place. Their row counts are taken
+ * from the tensor shapes because the result output of the post-processed model is dynamic.
+ */
+ResultData RTDETRPredictor::read_outputs(InferSlot& slot){
+    if (post_flag) {
+        ov::Tensor output_tensor = slot.request.get_output_tensor(model_info.result_index);
+        int rows = (int)output_tensor.get_shape()[0];
+        if (model_info.result_num_index >= 0) {
+            ov::Tensor num_tensor = slot.request.get_output_tensor(model_info.result_num_index);
+            int num = num_tensor.get_element_type() == ov::element::i64 ?
+                (int)num_tensor.data<int64_t>()[0] : (int)num_tensor.data<int32_t>()[0];
+            rows = std::min(rows, num);
+        }
+        slot.process.set_output_dims(rows, model_info.num_classes);
+        return slot.process.postprocess(output_tensor.data<float>(), nullptr, true);
+    }
+    ov::Tensor score_tensor = slot.request.get_output_tensor(model_info.score_index);
+    ov::Tensor bbox_tensor = slot.request.get_output_tensor(model_info.bbox_index);
+    int queries = (int)score_tensor.get_shape()[1];
+    if (queries != slot.process.get_num_queries()) {
+        slot.process.set_output_dims(queries, model_info.num_classes);
+    }
+    return slot.process.postprocess(score_tensor.data<float>(), bbox_tensor.data<float>(), false);
 }
 
 /**
@@ -126,39 +723,6 @@ void RTDETRPredictor::pritf_model_info(std::shared_ptr<ov::Model> model) {
     }
 }
 
-/**
- * The function `fill_tensor_data_image` fills an OpenVINO tensor with data from an input image.
- * 
- * @param input_tensor The input tensor is an instance of the ov::Tensor class, which represents a
- * multi-dimensional array of data. It is used to store the input data for the model.
- * @param input_image The input_image parameter is a cv::Mat object, which represents an image in
- * OpenCV. It is a multi-channel image with floating-point pixel values.
- */
-void RTDETRPredictor::fill_tensor_data_image(ov::Tensor& input_tensor, 
-    const cv::Mat& input_image) {
-    
-    // Retrieving the shape of the input tensor. The `get_shape()` function returns an `ov::Shape` 
-    // object, which represents the shape of the tensor. The shape is a vector of integers that 
-    // specifies the size of each dimension of the tensor. In this case, `tensor_shape` is assigned 
-    // the shape of the input tensor, which is then used to determine the width, height, and number 
-    // of channels of the input image. 
-    ov::Shape tensor_shape = input_tensor.get_shape();
-    const size_t width = tensor_shape[3]; 
-    const size_t height = tensor_shape[2];
-    const size_t channels = tensor_shape[1]; 
-    // Retrieving a pointer to the data buffer of the input tensor. It is used to access and modify 
-    // the values of the tensor. By assigning the pointer to `input_tensor_data`, you can directly 
-    // manipulate the data in the tensor using array indexing. 
-    float* input_tensor_data = input_tensor.data<float>();
-    // The code snippet is filling the input tensor with data from the input image. 
-    for (size_t c = 0; c < channels; c++) {
-        for (size_t h = 0; h < height; h++) {
-            for (size_t w = 0; w < width; w++) {
-                input_tensor_data[c * width * height + h * width + w] = input_image.at<cv::Vec<float, 3>>(h, w)[c];
-            }
-        }
-    }
-}
 /**
  * The function fills a tensor with float data from an input array.
  * 
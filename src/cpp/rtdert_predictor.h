@@ -10,30 +10,180 @@
 // @Description : 
 #ifndef __RTDETRPREDICTOR_H__
 #define __RTDETRPREDICTOR_H__
+#include <chrono>
+#include <cstdint>
+#include <cstring>
 #include "openvino/openvino.hpp"
 #include "opencv2/opencv.hpp"
 #include "process.h"
+#include "model_info.h"
+#include "model_bundle.h"
+#include "thread_budget.h"
+// The settings of a predictor beyond the model and device.
+struct PredictorOptions {
+    int num_requests;           // The infer requests of the pool, more than 1 compiles for throughput.
+    cv::Size fallback_size;     // The input size of a faster variant used when a deadline is tight, empty for none.
+    int cpu_threads;            // The CPU cores shared by the preprocess and the inference, 0 for the defaults.
+    bool pin_threads;           // Whether the preprocess threads are pinned to their cores.
+    cv::Size max_input_size;    // The largest input of a dynamic image input, empty for a static input.
+    int warmup_iterations;      // The warm-up rounds over every pooled request before the constructor returns.
+    bool prefault_weights;      // Whether the weight file is paged in before the model is read.
+    int max_requests;           // The cap on `num_requests`, 0 for none.
+    bool release_model;         // Whether the source ov::Model is released once compiled.
+    bool mmap_weights;          // Whether the weights are read through a memory mapping where supported.
+    ov::element::Type inference_precision;  // e.g. f16 or bf16, undefined for the device default.
+    bool pipelined;             // Whether the constructor sets up the double-buffered pair of `pipeline_push`.
+    PredictorOptions() : num_requests(1), cpu_threads(0), pin_threads(true), warmup_iterations(1),
+        prefault_weights(false), max_requests(0), release_model(false), mmap_weights(true),
+        inference_precision(ov::element::undefined), pipelined(false) {}
+    static PredictorOptions low_memory(ov::element::Type precision = ov::element::undefined);
+};
+
+struct WarmupStats {
+    int iterations;
+    double first_ms;            // The first inference after compiling, cold.
+    double steady_ms;           // The same request in the last warm-up round.
+    double warmup_ms;           // The whole warm-up, over all pooled requests.
+    double prefault_ms;
+    uint64_t prefault_bytes;    // The weight bytes paged in, 0 without prefault.
+};
+
+// The memory of a predictor. The RSS growths are measured around each loading step and are process
+// wide, so they also count the allocations of other threads meanwhile.
+struct MemoryStats {
+    uint64_t weight_bytes;      // The constants of the source ov::Model.
+    int64_t model_rss;          // Reading the source ov::Model.
+    int64_t compile_rss;        // Compiling it, the reduced resolution variant included.
+    int64_t requests_rss;       // Creating the pooled requests.
+    int64_t warmup_rss;         // The first inferences, which allocate the intermediate buffers.
+    int64_t released_rss;       // Given back by releasing the source ov::Model, 0 if kept.
+    uint64_t tensor_bytes;      // The input and output tensors of the pooled requests.
+    uint64_t host_bytes;        // The image buffers owned by the predictor and the label table.
+    uint64_t rss;               // The process, now.
+    uint64_t peak_rss;
+};
+
+enum class DeadlineStatus {
+    COMPLETED,                  // The detections are valid, see `DeadlineResult::met`.
+    SKIPPED,                    // Not started, the frame could not have finished in time.
+    CANCELLED,                  // Started, then cancelled at the deadline.
+};
+
+struct DeadlineResult {
+    DeadlineStatus status;
+    bool met;                   // Whether the detections were ready before the deadline.
+    bool used_fallback;         // Whether the reduced resolution variant produced them.
+    double latency_ms;
+    ResultData result;
+};
+
+struct DeadlineStats {
+    uint64_t frames;
+    uint64_t met;
+    uint64_t missed;            // Late, skipped or cancelled.
+    uint64_t late;              // Completed after the deadline.
+    uint64_t skipped;
+    uint64_t cancelled;
+    uint64_t fallback;          // Completed by the reduced resolution variant.
+    uint64_t render_skipped;
+    double primary_cost_ms;     // The running latency estimates the scheduler decides with.
+    double fallback_cost_ms;
+    double render_cost_ms;
+};
+
 class RTDETRPredictor
 {
 public:
     RTDETRPredictor(std::string model_path, std::string label_path, 
-        std::string device_name = "CPU", bool postprcoess = true);
+        std::string device_name = "CPU", bool postprcoess = true,
+        const PredictorOptions& options = PredictorOptions());
+
+    RTDETRPredictor(const ModelBundle& bundle, std::string device_name = "CPU",
+        const PredictorOptions& options = PredictorOptions());
 
     cv::Mat predict(cv::Mat image);
+
+    cv::Mat predict(cv::Mat image, std::chrono::steady_clock::time_point deadline);
+
+    cv::Mat predict_pipelined(cv::Mat image);
+
+    ResultData detect(cv::Mat image);
+
+    ResultData detect(const ImageView& image);
+
+    ResultData detect_encoded(const uint8_t* data, size_t size);
+
+    DeadlineResult detect(const ImageView& image, std::chrono::steady_clock::time_point deadline);
+
+    std::vector<ResultData> detect_batch(const std::vector<ImageView>& images);
+
+    bool pipeline_push(const ImageView& image, ResultData& previous);
+
+    bool pipeline_flush(ResultData& previous);
+
+    void set_filter(const FilterConfig& filter);
+
+    void set_nms(const NmsConfig& config);
+
+    int get_num_requests() { return (int)slots.size(); }
+
+    cv::Size get_input_size() { return model_info.input_size; }
+
+    std::shared_ptr<const LabelTable> get_labels() { return slots[0].process.get_labels(); }
+
+    DeadlineStats get_deadline_stats() { return deadline_stats; }
+
+    ThreadBudget get_thread_budget() { return thread_budget; }
+
+    WarmupStats warm_up(int iterations);
+
+    WarmupStats get_warmup_stats() { return warmup_stats; }
+
+    MemoryStats get_memory_stats();
 private:
+    // An infer request with the pre- and post-processing state of the image it holds.
+    struct InferSlot {
+        ov::InferRequest request;
+        RTDETRProcess process;
+        ov::Tensor image_tensor;        // The image input, allocated once at the largest input size.
+        cv::Size bound_size;            // The input size the request is currently bound to.
+        bool dynamic_input;             // Whether the input size follows the aspect ratio of the image.
+    };
+
+    void init_slot(InferSlot& slot, ov::CompiledModel& compiled, const RTDETRProcess& process,
+        bool dynamic_input);
+
     void pritf_model_info(std::shared_ptr<ov::Model> model);
 
-    void fill_tensor_data_image(ov::Tensor& input_tensor, const cv::Mat& input_image);
+    std::shared_ptr<const LabelTable> load_labels(const ModelBundle& bundle);
 
     void fill_tensor_data_float(ov::Tensor& input_tensor, float* input_data, int data_size);
 
+    void fill_inputs(InferSlot& slot, const ImageView& image);
+
+    ResultData read_outputs(InferSlot& slot);
+
+    void init_pipeline();
+
+    void count_buffer_bytes();
+
 private:
-    RTDETRProcess rtdetr_process;
     bool post_flag;
     ov::Core core;
-    std::shared_ptr<ov::Model> model;
+    std::shared_ptr<ov::Model> model;   // The source model, nullptr after compiling with `release_model`.
+    ModelInfo model_info;
     ov::CompiledModel compiled_model;
-    ov::InferRequest infer_request;
+    std::vector<InferSlot> slots;       // The request pool, `detect` uses the first slot.
+    ov::CompiledModel fallback_model;   // The reduced resolution variant, see `PredictorOptions::fallback_size`.
+    std::vector<InferSlot> fallback_slots;  // Its request, empty without a variant.
+    DeadlineStats deadline_stats;
+    WarmupStats warmup_stats;
+    MemoryStats memory_stats;
+    ThreadBudget thread_budget;         // The CPU split, all zero without `PredictorOptions::cpu_threads`.
+    std::vector<InferSlot> pipeline_slots;  // The ping-pong pair of the double-buffered mode.
+    int pipeline_index;                 // The slot the next frame goes to.
+    bool pipeline_pending;              // Whether the other slot holds a frame in flight.
+    cv::Mat pipeline_image;             // The frame in flight of `predict_pipelined`.
     
 };
 
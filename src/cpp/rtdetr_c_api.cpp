@@ -0,0 +1,308 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  23:21:37
+// @Brief  : This is common class.
+// @File    : rtdetr_c_api.cpp
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : 
+
+#include "rtdetr_c_api.h"
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "model_bundle.h"
+#include "rtdert_predictor.h"
+
+
+// The handle behind the opaque `rtdetr_predictor`. The calls on one handle are serialized, a caller
+// that wants parallel inference creates one handle per thread.
+struct rtdetr_predictor {
+    std::unique_ptr<RTDETRPredictor> predictor;
+    std::mutex mutex;
+};
+
+static thread_local std::string last_error;
+
+/**
+ * The function records the error of a failed call for `rtdetr_last_error`.
+ *
+ * @return the status to return.
+ */
+static int32_t fail(int32_t status, const std::string& message) {
+    last_error = message;
+    return status;
+}
+
+/**
+ * The function returns the bytes of a pixel of the packed plane, or of the Y plane of a YUV format.
+ */
+static int64_t bytes_per_pixel(int32_t format) {
+    switch (format) {
+    case RTDETR_FORMAT_BGR:
+    case RTDETR_FORMAT_RGB:
+        return 3;
+    case RTDETR_FORMAT_BGRA:
+    case RTDETR_FORMAT_RGBA:
+        return 4;
+    default:
+        return 1;
+    }
+}
+
+static PredictorOptions to_predictor_options(const rtdetr_options* options) {
+    rtdetr_options defaults;
+    if (options == nullptr) {
+        rtdetr_default_options(&defaults);
+        options = &defaults;
+    }
+    PredictorOptions out = options->low_memory ? PredictorOptions::low_memory() : PredictorOptions();
+    out.num_requests = std::max(options->num_requests, 1);
+    out.cpu_threads = options->cpu_threads;
+    out.warmup_iterations = options->warmup_iterations;
+    return out;
+}
+
+/**
+ * The function copies the detections into the caller array, as many as fit.
+ */
+static void copy_detections(const ResultData& result, rtdetr_detection* detections, int32_t capacity,
+    int32_t* count) {
+    int32_t total = (int32_t)result.clsids.size();
+    int32_t n = std::min(total, std::max(capacity, 0));
+    for (int32_t i = 0; i < n; ++i) {
+        rtdetr_detection& d = detections[i];
+        d.clsid = result.clsids[i];
+        d.score = result.scores[i];
+        d.x = (float)result.bboxs[i].x;
+        d.y = (float)result.bboxs[i].y;
+        d.width = (float)result.bboxs[i].width;
+        d.height = (float)result.bboxs[i].height;
+    }
+    *count = total;
+}
+
+/**
+ * The function runs one detection under the lock of the handle and turns an exception into a status.
+ */
+template <class Detect>
+static int32_t run_detect(rtdetr_predictor* predictor, rtdetr_detection* detections, int32_t capacity,
+    int32_t* count, Detect detect) {
+    if (predictor == nullptr || count == nullptr || (detections == nullptr && capacity > 0)) {
+        return fail(RTDETR_INVALID_ARGUMENT, "A null predictor, detection array or count.");
+    }
+    try {
+        std::lock_guard<std::mutex> lock(predictor->mutex);
+        copy_detections(detect(*predictor->predictor), detections, capacity, count);
+        return RTDETR_OK;
+    }
+    catch (const std::exception& e) {
+        return fail(RTDETR_ERROR, e.what());
+    }
+    catch (...) {
+        return fail(RTDETR_ERROR, "An unknown error.");
+    }
+}
+
+/**
+ * The function `rtdetr_default_options` fills the options of `rtdetr_create` with the defaults of
+ * `PredictorOptions`.
+ */
+void rtdetr_default_options(rtdetr_options* options) {
+    if (options == nullptr) {
+        return;
+    }
+    PredictorOptions defaults;
+    options->num_requests = defaults.num_requests;
+    options->cpu_threads = defaults.cpu_threads;
+    options->warmup_iterations = defaults.warmup_iterations;
+    options->low_memory = 0;
+}
+
+/**
+ * The function `rtdetr_create` loads and compiles a model.
+ *
+ * @param model_path, label_path The model and label files, the label path may be null or empty.
+ * @param device_name The device, e.g. "CPU" or "GPU.0", null for "CPU".
+ * @param post_flag Non-zero if the model includes the post-processing layers.
+ * @param options The options, null for the defaults.
+ * @param predictor Receives the handle, to be released with `rtdetr_destroy`.
+ */
+int32_t rtdetr_create(const char* model_path, const char* label_path, const char* device_name,
+    int32_t post_flag, const rtdetr_options* options, rtdetr_predictor** predictor) {
+    if (model_path == nullptr || predictor == nullptr) {
+        return fail(RTDETR_INVALID_ARGUMENT, "A null model path or predictor.");
+    }
+    try {
+        ModelBundle bundle = ModelBundle::from_paths(model_path, label_path != nullptr ? label_path : "",
+            post_flag != 0);
+        std::unique_ptr<rtdetr_predictor> handle(new rtdetr_predictor());
+        handle->predictor.reset(new RTDETRPredictor(bundle, device_name != nullptr ? device_name : "CPU",
+            to_predictor_options(options)));
+        *predictor = handle.release();
+        return RTDETR_OK;
+    }
+    catch (const std::exception& e) {
+        return fail(RTDETR_ERROR, e.what());
+    }
+    catch (...) {
+        return fail(RTDETR_ERROR, "An unknown error.");
+    }
+}
+
+/**
+ * The function `rtdetr_create_from_bundle` loads and compiles the model of a bundle, see `load_bundle`.
+ *
+ * @param bundle_path The bundle directory or its manifest.
+ */
+int32_t rtdetr_create_from_bundle(const char* bundle_path, const char* device_name,
+    const rtdetr_options* options, rtdetr_predictor** predictor) {
+    if (bundle_path == nullptr || predictor == nullptr) {
+        return fail(RTDETR_INVALID_ARGUMENT, "A null bundle path or predictor.");
+    }
+    try {
+        ModelBundle bundle = load_bundle(bundle_path);
+        std::unique_ptr<rtdetr_predictor> handle(new rtdetr_predictor());
+        handle->predictor.reset(new RTDETRPredictor(bundle, device_name != nullptr ? device_name : "CPU",
+            to_predictor_options(options)));
+        *predictor = handle.release();
+        return RTDETR_OK;
+    }
+    catch (const std::exception& e) {
+        return fail(RTDETR_ERROR, e.what());
+    }
+    catch (...) {
+        return fail(RTDETR_ERROR, "An unknown error.");
+    }
+}
+
+void rtdetr_destroy(rtdetr_predictor* predictor) {
+    delete predictor;
+}
+
+/**
+ * The function `rtdetr_detect` detects the objects in a caller-owned image buffer. The buffer is read
+ * in place by the fused preprocess, nothing is copied. The chroma planes of a YUV image follow the
+ * Y plane, with the same stride for NV12/NV21 and half the stride (rounded up) for I420;
+ * `rtdetr_detect_planes` takes separate planes.
+ *
+ * @param data, width, height, stride The image and its bytes per row, at least the bytes of `width`
+ * pixels.
+ * @param format One of the RTDETR_FORMAT_* values.
+ * @param detections, capacity The caller array of the detections.
+ * @param count Receives the number of detections, more than `capacity` if some were left out.
+ */
+int32_t rtdetr_detect(rtdetr_predictor* predictor, const uint8_t* data, int32_t width, int32_t height,
+    int32_t stride, int32_t format, rtdetr_detection* detections, int32_t capacity, int32_t* count) {
+    if (data == nullptr || width <= 0 || height <= 0 || format < RTDETR_FORMAT_BGR ||
+        format > RTDETR_FORMAT_I420) {
+        return fail(RTDETR_INVALID_ARGUMENT, "An empty image or unknown pixel format.");
+    }
+    if (stride < width * bytes_per_pixel(format)) {
+        return fail(RTDETR_INVALID_ARGUMENT, "The stride is shorter than a row of the image.");
+    }
+    const uint8_t* planes[3] = { data, nullptr, nullptr };
+    int32_t strides[3] = { stride, 0, 0 };
+    if (format == RTDETR_FORMAT_NV12 || format == RTDETR_FORMAT_NV21) {
+        planes[1] = data + (size_t)stride * height;
+        strides[1] = stride;
+    } else if (format == RTDETR_FORMAT_I420) {
+        planes[1] = data + (size_t)stride * height;
+        strides[1] = stride / 2 + stride % 2;
+        planes[2] = planes[1] + (size_t)strides[1] * ((height + 1) / 2);
+        strides[2] = strides[1];
+    }
+    return rtdetr_detect_planes(predictor, planes, strides, width, height, format, detections, capacity, count);
+}
+
+/**
+ * The function `rtdetr_detect_planes` detects the objects in an image given by its planes, e.g. the Y
+ * and UV planes of a camera buffer.
+ *
+ * @param planes, strides The packed or Y plane, then the chroma planes of the YUV formats. A stride
+ * must hold a row of its plane: `width` pixels, the interleaved UV pairs of (width + 1) / 2 pixels for
+ * NV12/NV21, (width + 1) / 2 bytes for the U and V planes of I420.
+ */
+int32_t rtdetr_detect_planes(rtdetr_predictor* predictor, const uint8_t* const* planes,
+    const int32_t* strides, int32_t width, int32_t height, int32_t format, rtdetr_detection* detections,
+    int32_t capacity, int32_t* count) {
+    if (planes == nullptr || strides == nullptr || planes[0] == nullptr || width <= 0 || height <= 0 ||
+        format < RTDETR_FORMAT_BGR || format > RTDETR_FORMAT_I420) {
+        return fail(RTDETR_INVALID_ARGUMENT, "An empty image or unknown pixel format.");
+    }
+    if (strides[0] < width * bytes_per_pixel(format)) {
+        return fail(RTDETR_INVALID_ARGUMENT, "The stride is shorter than a row of the image.");
+    }
+    PixelFormat pixel_format = (PixelFormat)format;
+    ImageView view = ImageView::packed(planes[0], width, height, (size_t)strides[0], pixel_format);
+    int chroma_planes = format == RTDETR_FORMAT_I420 ? 2 : format >= RTDETR_FORMAT_NV12 ? 1 : 0;
+    int64_t chroma_row = ((int64_t)width + 1) / 2 * (format == RTDETR_FORMAT_I420 ? 1 : 2);
+    for (int p = 1; p <= chroma_planes; ++p) {
+        if (planes[p] == nullptr) {
+            return fail(RTDETR_INVALID_ARGUMENT, "A missing chroma plane.");
+        }
+        if (strides[p] < chroma_row) {
+            return fail(RTDETR_INVALID_ARGUMENT, "A chroma stride is negative or shorter than a row of its plane.");
+        }
+        view.planes[p] = planes[p];
+        view.strides[p] = (size_t)strides[p];
+    }
+    return run_detect(predictor, detections, capacity, count,
+        [&view](RTDETRPredictor& p) { return p.detect(view); });
+}
+
+/**
+ * The function `rtdetr_detect_encoded` detects the objects in an encoded image (JPEG, PNG, ...).
+ */
+int32_t rtdetr_detect_encoded(rtdetr_predictor* predictor, const uint8_t* data, size_t size,
+    rtdetr_detection* detections, int32_t capacity, int32_t* count) {
+    if (data == nullptr || size == 0) {
+        return fail(RTDETR_INVALID_ARGUMENT, "An empty encoded image.");
+    }
+    return run_detect(predictor, detections, capacity, count,
+        [data, size](RTDETRPredictor& p) { return p.detect_encoded(data, size); });
+}
+
+int32_t rtdetr_get_input_size(rtdetr_predictor* predictor, int32_t* width, int32_t* height) {
+    if (predictor == nullptr || width == nullptr || height == nullptr) {
+        return fail(RTDETR_INVALID_ARGUMENT, "A null predictor or size.");
+    }
+    cv::Size size = predictor->predictor->get_input_size();
+    *width = size.width;
+    *height = size.height;
+    return RTDETR_OK;
+}
+
+/**
+ * The function `rtdetr_get_label` copies the label of a class, truncated to `size` - 1 characters
+ * and null-terminated.
+ *
+ * @return the length of the whole label, 0 without labels, or a negative status.
+ */
+int32_t rtdetr_get_label(rtdetr_predictor* predictor, int32_t clsid, char* buffer, int32_t size) {
+    if (predictor == nullptr || (buffer == nullptr && size > 0)) {
+        return fail(RTDETR_INVALID_ARGUMENT, "A null predictor or buffer.");
+    }
+    std::shared_ptr<const LabelTable> labels = predictor->predictor->get_labels();
+    std::string label = labels ? labels->get(clsid) : std::string();
+    if (size > 0) {
+        size_t n = std::min(label.size(), (size_t)size - 1);
+        std::memcpy(buffer, label.data(), n);
+        buffer[n] = '\0';
+    }
+    return (int32_t)label.size();
+}
+
+/**
+ * The function `rtdetr_last_error` returns the message of the last failed call of this thread, valid
+ * until the next call that fails.
+ */
+const char* rtdetr_last_error(void) {
+    return last_error.c_str();
+}
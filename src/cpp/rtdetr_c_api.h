@@ -0,0 +1,103 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  23:08:52
+// @Brief  : This is common class.
+// @File    : rtdetr_c_api.h
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : The C interface of the predictor, built as the `rtdetr_c` shared library for the C# and
+//                Python front ends. Only C types cross the boundary: an opaque handle, caller-owned
+//                image buffers that are read in place, and caller-owned detection arrays. A function
+//                returns RTDETR_OK or a negative status, `rtdetr_last_error` tells why.
+//
+//                Existing structs, functions and values keep their layout and meaning, new ones are
+//                only appended.
+#ifndef __RTDETR_C_API_H__
+#define __RTDETR_C_API_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#if defined(RTDETR_C_API_EXPORTS)
+#define RTDETR_API __declspec(dllexport)
+#else
+#define RTDETR_API __declspec(dllimport)
+#endif
+#else
+#define RTDETR_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct rtdetr_predictor rtdetr_predictor;
+
+// The status of a call.
+#define RTDETR_OK                   0
+#define RTDETR_INVALID_ARGUMENT     -1
+#define RTDETR_ERROR                -2
+
+// The pixel formats of `rtdetr_detect`, the values of `PixelFormat`.
+#define RTDETR_FORMAT_BGR           0
+#define RTDETR_FORMAT_RGB           1
+#define RTDETR_FORMAT_BGRA          2
+#define RTDETR_FORMAT_RGBA          3
+#define RTDETR_FORMAT_GRAY          4
+#define RTDETR_FORMAT_NV12          5
+#define RTDETR_FORMAT_NV21          6
+#define RTDETR_FORMAT_I420          7
+
+// The options of `rtdetr_create`, filled with the defaults by `rtdetr_default_options`.
+typedef struct rtdetr_options {
+    int32_t num_requests;       // The infer requests of the pool.
+    int32_t cpu_threads;        // The CPU cores shared by the preprocess and the inference, 0 for the defaults.
+    int32_t warmup_iterations;  // The warm-up rounds before `rtdetr_create` returns.
+    int32_t low_memory;         // Non-zero for `PredictorOptions::low_memory`.
+} rtdetr_options;
+
+// One detection, in pixels of the input image.
+typedef struct rtdetr_detection {
+    int32_t clsid;
+    float score;
+    float x;
+    float y;
+    float width;
+    float height;
+} rtdetr_detection;
+
+RTDETR_API void rtdetr_default_options(rtdetr_options* options);
+
+RTDETR_API int32_t rtdetr_create(const char* model_path, const char* label_path, const char* device_name,
+    int32_t post_flag, const rtdetr_options* options, rtdetr_predictor** predictor);
+
+RTDETR_API int32_t rtdetr_create_from_bundle(const char* bundle_path, const char* device_name,
+    const rtdetr_options* options, rtdetr_predictor** predictor);
+
+RTDETR_API void rtdetr_destroy(rtdetr_predictor* predictor);
+
+RTDETR_API int32_t rtdetr_detect(rtdetr_predictor* predictor, const uint8_t* data, int32_t width,
+    int32_t height, int32_t stride, int32_t format, rtdetr_detection* detections, int32_t capacity,
+    int32_t* count);
+
+RTDETR_API int32_t rtdetr_detect_planes(rtdetr_predictor* predictor, const uint8_t* const* planes,
+    const int32_t* strides, int32_t width, int32_t height, int32_t format, rtdetr_detection* detections,
+    int32_t capacity, int32_t* count);
+
+RTDETR_API int32_t rtdetr_detect_encoded(rtdetr_predictor* predictor, const uint8_t* data, size_t size,
+    rtdetr_detection* detections, int32_t capacity, int32_t* count);
+
+RTDETR_API int32_t rtdetr_get_input_size(rtdetr_predictor* predictor, int32_t* width, int32_t* height);
+
+RTDETR_API int32_t rtdetr_get_label(rtdetr_predictor* predictor, int32_t clsid, char* buffer, int32_t size);
+
+RTDETR_API const char* rtdetr_last_error(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // !__RTDETR_C_API_H__
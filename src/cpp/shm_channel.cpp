@@ -0,0 +1,136 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  14:20:18
+// @Brief  : This is common class.
+// @File    : shm_channel.cpp
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : 
+
+#include "shm_channel.h"
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+static size_t header_bytes() {
+    return (sizeof(ShmChannelHeader) + 63) / 64 * 64;
+}
+
+static std::runtime_error shm_error(const std::string& what, const std::string& name) {
+    return std::runtime_error(what + " '" + name + "' failed: " + std::strerror(errno));
+}
+
+ShmChannel::~ShmChannel() {
+    close();
+}
+
+/**
+ * The function returns the POSIX shared-memory object name of a channel.
+ */
+std::string ShmChannel::shm_name(const std::string& channel) {
+    return "/rtdetr_" + channel;
+}
+
+/**
+ * The function `create` creates and maps a channel, replacing a stale one left by a crashed server.
+ * The creator owns the channel and unlinks it on `close`.
+ *
+ * @param channel The channel name, producers open the channel with the same name.
+ * @param slot_count The number of frame slots, at most SHM_RING_SIZE.
+ * @param slot_bytes The capacity of a frame slot in bytes.
+ */
+void ShmChannel::create(const std::string& channel, uint32_t slot_count, uint64_t slot_bytes) {
+    close();
+    if (slot_count == 0 || slot_count > SHM_RING_SIZE) {
+        throw std::invalid_argument("The slot count must be in [1, SHM_RING_SIZE].");
+    }
+    name = shm_name(channel);
+    slot_bytes = (slot_bytes + 63) / 64 * 64;
+    shm_unlink(name.c_str());
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0660);
+    if (fd < 0) {
+        throw shm_error("shm_open", name);
+    }
+    map_bytes = header_bytes() + slot_count * slot_bytes;
+    if (ftruncate(fd, (off_t)map_bytes) != 0) {
+        ::close(fd);
+        shm_unlink(name.c_str());
+        throw shm_error("ftruncate", name);
+    }
+    void* base = mmap(nullptr, map_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        shm_unlink(name.c_str());
+        throw shm_error("mmap", name);
+    }
+    owner = true;
+    header = new (base) ShmChannelHeader();
+    header->slot_count = slot_count;
+    header->slot_bytes = slot_bytes;
+    header->submit.init();
+    header->complete.init();
+    header->server_state.store(1, std::memory_order_relaxed);
+    header->version = SHM_VERSION;
+    // The magic is published last, a producer treats the channel as ready once it sees it.
+    header->magic.store(SHM_MAGIC, std::memory_order_release);
+    slots = static_cast<uint8_t*>(base) + header_bytes();
+}
+
+/**
+ * The function `open` maps an existing channel created by the server.
+ *
+ * @param channel The channel name passed to the server.
+ */
+void ShmChannel::open(const std::string& channel) {
+    close();
+    name = shm_name(channel);
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0) {
+        throw shm_error("shm_open", name);
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < header_bytes()) {
+        ::close(fd);
+        throw std::runtime_error("The shared-memory channel '" + name + "' is not initialized.");
+    }
+    map_bytes = (size_t)st.st_size;
+    void* base = mmap(nullptr, map_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        throw shm_error("mmap", name);
+    }
+    header = static_cast<ShmChannelHeader*>(base);
+    if (header->magic.load(std::memory_order_acquire) != SHM_MAGIC || header->version != SHM_VERSION ||
+        header_bytes() + header->slot_count * header->slot_bytes > map_bytes) {
+        close();
+        throw std::runtime_error("The shared-memory channel '" + name + "' has an unknown layout.");
+    }
+    slots = static_cast<uint8_t*>(base) + header_bytes();
+}
+
+/**
+ * The function unmaps the channel, and unlinks it if this process created it.
+ */
+void ShmChannel::close() {
+    if (header == nullptr) {
+        return;
+    }
+    if (owner) {
+        header->server_state.store(0, std::memory_order_release);
+        shm_unlink(name.c_str());
+    }
+    munmap(header, map_bytes);
+    header = nullptr;
+    slots = nullptr;
+    map_bytes = 0;
+    owner = false;
+}
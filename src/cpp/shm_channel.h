@@ -0,0 +1,134 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  14:12:40
+// @Brief  : This is common class.
+// @File    : shm_channel.h
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : The POSIX shared-memory layout shared by the inference server and its producers.
+#ifndef __SHM_CHANNEL_H__
+#define __SHM_CHANNEL_H__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "pixel_format.h"
+
+#if ATOMIC_INT_LOCK_FREE != 2
+#error "The shared-memory rings need lock-free std::atomic<uint32_t>."
+#endif
+
+const uint32_t SHM_MAGIC = 0x52544452;      // "RTDR"
+const uint32_t SHM_VERSION = 1;
+const uint32_t SHM_RING_SIZE = 16;          // The ring capacity, a power of 2.
+const uint32_t SHM_MAX_DETECTIONS = 100;    // The detections a completion record can carry.
+
+// A frame written into a slot by the producer.
+struct ShmFrame {
+    uint64_t frame_id;
+    uint32_t slot;
+    int32_t width;
+    int32_t height;
+    int32_t format;             // A PixelFormat value.
+    uint32_t offsets[3];        // The plane offsets from the start of the slot.
+    uint32_t strides[3];
+};
+
+struct ShmDetection {
+    int32_t clsid;
+    float score;
+    float x, y, width, height;
+};
+
+// The detections of a frame, sent back to the producer. The slot is free again once it is received.
+struct ShmCompletion {
+    uint64_t frame_id;
+    uint32_t slot;
+    int32_t status;             // 0 on success, -1 if the frame could not be processed.
+    uint32_t count;
+    ShmDetection detections[SHM_MAX_DETECTIONS];
+};
+
+/**
+ * A lock-free single-producer single-consumer ring that lives in shared memory. The producer only
+ * writes `tail`, the consumer only writes `head`; the release/acquire pairs order the item copies.
+ */
+template<class T>
+struct SpscRing {
+    alignas(64) std::atomic<uint32_t> head;
+    alignas(64) std::atomic<uint32_t> tail;
+    alignas(64) T items[SHM_RING_SIZE];
+
+    void init() {
+        head.store(0, std::memory_order_relaxed);
+        tail.store(0, std::memory_order_relaxed);
+    }
+    bool full() const {
+        return tail.load(std::memory_order_relaxed) - head.load(std::memory_order_acquire) == SHM_RING_SIZE;
+    }
+    bool empty() const {
+        return tail.load(std::memory_order_acquire) == head.load(std::memory_order_relaxed);
+    }
+    bool push(const T& item) {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == SHM_RING_SIZE) {
+            return false;
+        }
+        items[t % SHM_RING_SIZE] = item;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+    // Returns the oldest item without removing it, or nullptr if the ring is empty.
+    const T* front() const {
+        uint32_t h = head.load(std::memory_order_relaxed);
+        if (tail.load(std::memory_order_acquire) == h) {
+            return nullptr;
+        }
+        return &items[h % SHM_RING_SIZE];
+    }
+    void pop() {
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+};
+
+struct ShmChannelHeader {
+    std::atomic<uint32_t> magic;            // Published last, with a release store.
+    uint32_t version;
+    uint32_t slot_count;
+    uint32_t reserved;
+    uint64_t slot_bytes;
+    std::atomic<uint32_t> server_state;     // 1 while the server serves the channel.
+    SpscRing<ShmFrame> submit;              // Producer -> server.
+    SpscRing<ShmCompletion> complete;       // Server -> producer.
+};
+
+// A mapping of one channel: the header followed by `slot_count` frame slots of `slot_bytes` each.
+class ShmChannel
+{
+public:
+    ShmChannel() : header(nullptr), slots(nullptr), map_bytes(0), owner(false) {}
+    ~ShmChannel();
+    static std::string shm_name(const std::string& channel);
+    void create(const std::string& channel, uint32_t slot_count, uint64_t slot_bytes);
+    void open(const std::string& channel);
+    void close();
+    ShmChannelHeader* get_header() { return header; }
+    uint8_t* get_slot(uint32_t slot) { return slots + slot * header->slot_bytes; }
+
+private:
+    ShmChannel(const ShmChannel&);
+    ShmChannel& operator=(const ShmChannel&);
+
+private:
+    std::string name;
+    ShmChannelHeader* header;
+    uint8_t* slots;
+    size_t map_bytes;
+    bool owner;                 // Whether this process created the channel and unlinks it.
+};
+
+#endif // !__SHM_CHANNEL_H__
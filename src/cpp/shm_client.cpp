@@ -0,0 +1,204 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  14:38:12
+// @Brief  : This is common class.
+// @File    : shm_client.cpp
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : 
+
+#include "shm_client.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+
+/**
+ * The function fills the plane offsets and strides of a tightly packed frame, the chroma planes of
+ * the YUV formats follow the Y plane.
+ */
+static void packed_layout(int width, int height, PixelFormat format, uint32_t* offsets, uint32_t* strides) {
+    uint32_t area = (uint32_t)width * height;
+    uint32_t chroma_w = (uint32_t)(width + 1) / 2;
+    uint32_t chroma_h = (uint32_t)(height + 1) / 2;
+    offsets[0] = offsets[1] = offsets[2] = 0;
+    strides[1] = strides[2] = 0;
+    switch (format) {
+    case PixelFormat::BGR:
+    case PixelFormat::RGB: strides[0] = width * 3; break;
+    case PixelFormat::BGRA:
+    case PixelFormat::RGBA: strides[0] = width * 4; break;
+    case PixelFormat::GRAY: strides[0] = width; break;
+    case PixelFormat::I420:
+        strides[0] = width;
+        offsets[1] = area;
+        strides[1] = chroma_w;
+        offsets[2] = area + chroma_w * chroma_h;
+        strides[2] = chroma_w;
+        break;
+    default:
+        strides[0] = width;
+        offsets[1] = area;
+        strides[1] = chroma_w * 2;
+        break;
+    }
+}
+
+/**
+ * The function fills the plane offsets of a frame whose planes follow each other with the given
+ * strides, e.g. rows padded by the producer.
+ */
+static void plane_offsets(int height, const uint32_t* strides, uint32_t* offsets) {
+    offsets[0] = 0;
+    offsets[1] = strides[1] != 0 ? strides[0] * (uint32_t)height : 0;
+    offsets[2] = strides[2] != 0 ? offsets[1] + strides[1] * (uint32_t)((height + 1) / 2) : 0;
+}
+
+/**
+ * The ShmClient constructor opens a channel created by the inference server.
+ *
+ * @param channel The channel name passed to the server.
+ */
+ShmClient::ShmClient(const std::string& channel) {
+    this->channel.open(channel);
+    slot_count = this->channel.get_header()->slot_count;
+    for (uint32_t i = slot_count; i > 0; --i) {
+        free_slots.push_back(i - 1);
+    }
+}
+
+/**
+ * The function `acquire` takes a free frame slot, so that the producer can write (or decode) the frame
+ * straight into shared memory before calling `submit`.
+ *
+ * @return false if all slots are in flight.
+ */
+bool ShmClient::acquire(ShmSlot& slot) {
+    if (free_slots.empty()) {
+        return false;
+    }
+    slot.index = free_slots.back();
+    free_slots.pop_back();
+    slot.data = channel.get_slot(slot.index);
+    slot.capacity = channel.get_header()->slot_bytes;
+    return true;
+}
+
+/**
+ * The function `submit` queues the frame in an acquired slot for inference.
+ *
+ * @param slot The slot returned by `acquire`.
+ * @param frame_id The id returned with the detections of the frame.
+ * @param strides, offsets The plane strides and the plane offsets from the start of the slot, or nullptr
+ * for a tightly packed frame. Strides without offsets place the planes one after another.
+ *
+ * @return false if the frame does not fit into the slot, the slot is released in that case.
+ */
+bool ShmClient::submit(const ShmSlot& slot, uint64_t frame_id, int width, int height, PixelFormat format,
+    const uint32_t* strides, const uint32_t* offsets) {
+    ShmFrame frame;
+    frame.frame_id = frame_id;
+    frame.slot = slot.index;
+    frame.width = width;
+    frame.height = height;
+    frame.format = (int32_t)format;
+    packed_layout(width, height, format, frame.offsets, frame.strides);
+    if (strides != nullptr) {
+        std::memcpy(frame.strides, strides, sizeof(frame.strides));
+        plane_offsets(height, frame.strides, frame.offsets);
+    }
+    if (offsets != nullptr) {
+        std::memcpy(frame.offsets, offsets, sizeof(frame.offsets));
+    }
+    uint64_t end = frame.offsets[0] + (uint64_t)frame.strides[0] * height;
+    for (int p = 1; p < 3; ++p) {
+        if (frame.strides[p] != 0) {
+            end = std::max(end, frame.offsets[p] + (uint64_t)frame.strides[p] * ((height + 1) / 2));
+        }
+    }
+    // Every slot has its own entry in the ring, so the push only fails for an invalid frame.
+    if (width <= 0 || height <= 0 || end > slot.capacity || !channel.get_header()->submit.push(frame)) {
+        free_slots.push_back(slot.index);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * The function `submit_copy` copies a frame from producer memory into a free slot and submits it. The
+ * chroma planes of a YUV frame must follow the Y plane, with the same stride for NV12/NV21 and half the
+ * stride, rounded up, for I420.
+ *
+ * @param stride The bytes per row of the packed or Y plane.
+ *
+ * @return false if no slot is free or the frame does not fit into a slot.
+ */
+bool ShmClient::submit_copy(const uint8_t* data, int width, int height, size_t stride, PixelFormat format,
+    uint64_t frame_id) {
+    ShmSlot slot;
+    if (!acquire(slot)) {
+        return false;
+    }
+    uint32_t offsets[3], strides[3];
+    packed_layout(width, height, format, offsets, strides);
+    if (packed_image_bytes(format, width, height) > slot.capacity) {
+        free_slots.push_back(slot.index);
+        return false;
+    }
+    const uint8_t* src = data;
+    for (int p = 0; p < 3; ++p) {
+        if (strides[p] == 0) {
+            continue;
+        }
+        size_t src_stride = p == 0 || format != PixelFormat::I420 ? stride : (stride + 1) / 2;
+        int rows = p == 0 ? height : (height + 1) / 2;
+        for (int y = 0; y < rows; ++y) {
+            std::memcpy(slot.data + offsets[p] + (size_t)y * strides[p], src + y * src_stride, strides[p]);
+        }
+        src += rows * src_stride;
+    }
+    return submit(slot, frame_id, width, height, format, strides, offsets);
+}
+
+/**
+ * The function `poll` receives the detections of one completed frame if there is one, and releases its
+ * slot. It never blocks.
+ */
+bool ShmClient::poll(ShmResult& result) {
+    SpscRing<ShmCompletion>& ring = channel.get_header()->complete;
+    const ShmCompletion* completion = ring.front();
+    if (completion == nullptr) {
+        return false;
+    }
+    result.frame_id = completion->frame_id;
+    result.status = completion->status;
+    uint32_t count = std::min(completion->count, SHM_MAX_DETECTIONS);
+    result.detections.assign(completion->detections, completion->detections + count);
+    free_slots.push_back(completion->slot);
+    ring.pop();
+    return true;
+}
+
+/**
+ * The function `wait` waits up to `timeout_ms` for a completed frame, spinning briefly before it
+ * backs off to short sleeps.
+ */
+bool ShmClient::wait(ShmResult& result, int timeout_ms) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    for (int spin = 0; ; ++spin) {
+        if (poll(result)) {
+            return true;
+        }
+        if (std::chrono::steady_clock::now() >= deadline || !server_alive()) {
+            return false;
+        }
+        if (spin < 1000) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+}
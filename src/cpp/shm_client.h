@@ -0,0 +1,54 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  14:31:56
+// @Brief  : This is common class.
+// @File    : shm_client.h
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : The producer side of the shared-memory inference server. It does not depend on
+//                OpenVINO or OpenCV.
+#ifndef __SHM_CLIENT_H__
+#define __SHM_CLIENT_H__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "shm_channel.h"
+
+// A frame slot acquired from the channel, the producer writes the frame straight into `data`.
+struct ShmSlot {
+    uint32_t index;
+    uint8_t* data;
+    uint64_t capacity;
+};
+
+struct ShmResult {
+    uint64_t frame_id;
+    int status;
+    std::vector<ShmDetection> detections;
+};
+
+class ShmClient
+{
+public:
+    explicit ShmClient(const std::string& channel);
+    bool acquire(ShmSlot& slot);
+    bool submit(const ShmSlot& slot, uint64_t frame_id, int width, int height, PixelFormat format,
+        const uint32_t* strides = nullptr, const uint32_t* offsets = nullptr);
+    bool submit_copy(const uint8_t* data, int width, int height, size_t stride, PixelFormat format,
+        uint64_t frame_id);
+    bool poll(ShmResult& result);
+    bool wait(ShmResult& result, int timeout_ms);
+    bool server_alive() { return channel.get_header()->server_state.load(std::memory_order_acquire) == 1; }
+    int in_flight() { return (int)(free_slots.size() < slot_count ? slot_count - free_slots.size() : 0); }
+
+private:
+    ShmChannel channel;
+    uint32_t slot_count;
+    std::vector<uint32_t> free_slots;   // The slots neither submitted nor acquired.
+};
+
+#endif // !__SHM_CLIENT_H__
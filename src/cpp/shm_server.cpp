@@ -0,0 +1,163 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  14:52:27
+// @Brief  : This is common class.
+// @File    : shm_server.cpp
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : The inference server daemon. It keeps one compiled model resident and serves the
+//                frames that producer processes write into shared-memory channels. SIGHUP reloads the
+//                model files and swaps the new model in without stopping the channels.
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "model_swapper.h"
+#include "rtdert_predictor.h"
+#include "shm_channel.h"
+
+
+static volatile std::sig_atomic_t stop_flag = 0;
+static volatile std::sig_atomic_t reload_flag = 0;
+
+static void on_signal(int) {
+    stop_flag = 1;
+}
+
+static void on_reload(int) {
+    reload_flag = 1;
+}
+
+/**
+ * The function runs one frame of a channel through the predictor and fills its completion record.
+ */
+static void serve_frame(RTDETRPredictor& predictor, ShmChannel& channel, const ShmFrame& frame,
+    ShmCompletion& completion) {
+    completion.frame_id = frame.frame_id;
+    completion.slot = frame.slot;
+    completion.status = -1;
+    completion.count = 0;
+    ShmChannelHeader* header = channel.get_header();
+    if (frame.slot >= header->slot_count || frame.width <= 0 || frame.height <= 0 ||
+        frame.format < (int)PixelFormat::BGR || frame.format > (int)PixelFormat::I420) {
+        return;
+    }
+    const uint8_t* slot = channel.get_slot(frame.slot);
+    PixelFormat format = (PixelFormat)frame.format;
+    // The planes must stay inside the slot, the producer is not trusted: every plane of the format needs
+    // a stride that holds a row of it, and its last row must end inside the slot.
+    int planes = plane_count(format);
+    uint64_t end = 0;
+    for (int p = 0; p < planes; ++p) {
+        if (frame.strides[p] < plane_row_bytes(format, frame.width, p)) {
+            return;
+        }
+        int rows = p == 0 ? frame.height : (frame.height + 1) / 2;
+        end = std::max(end, frame.offsets[p] + (uint64_t)frame.strides[p] * rows);
+    }
+    if (end > header->slot_bytes) {
+        return;
+    }
+    ImageView view = ImageView::packed(slot + frame.offsets[0], frame.width, frame.height,
+        frame.strides[0], format);
+    for (int p = 1; p < planes; ++p) {
+        view.planes[p] = slot + frame.offsets[p];
+        view.strides[p] = frame.strides[p];
+    }
+    try {
+        ResultData result = predictor.detect(view);
+        uint32_t count = (uint32_t)std::min(result.clsids.size(), (size_t)SHM_MAX_DETECTIONS);
+        for (uint32_t i = 0; i < count; ++i) {
+            ShmDetection& d = completion.detections[i];
+            d.clsid = result.clsids[i];
+            d.score = result.scores[i];
+            d.x = (float)result.bboxs[i].x;
+            d.y = (float)result.bboxs[i].y;
+            d.width = (float)result.bboxs[i].width;
+            d.height = (float)result.bboxs[i].height;
+        }
+        completion.count = count;
+        completion.status = 0;
+    }
+    catch (const std::exception& e) {
+        INFO("Frame " << frame.frame_id << " failed: " << e.what());
+    }
+}
+
+/**
+ * The function serves the channels round-robin until SIGINT/SIGTERM, and starts a reload on SIGHUP. A
+ * frame is only taken when its completion ring has room, so a producer that stops receiving only stalls
+ * its own channel. When all rings are idle the loop spins briefly, then backs off to short sleeps.
+ */
+static void serve(ModelSwapper& swapper, std::vector<std::unique_ptr<ShmChannel>>& channels) {
+    ShmCompletion completion;
+    int idle = 0;
+    while (!stop_flag) {
+        if (reload_flag) {
+            reload_flag = 0;
+            if (!swapper.reload()) {
+                INFO("A reload is already running.");
+            }
+        }
+        // The predictor of this round, a swap takes effect at the next round.
+        std::shared_ptr<RTDETRPredictor> predictor = swapper.acquire();
+        bool busy = false;
+        for (size_t c = 0; c < channels.size(); ++c) {
+            ShmChannelHeader* header = channels[c]->get_header();
+            const ShmFrame* frame = header->submit.front();
+            if (frame == nullptr || header->complete.full()) {
+                continue;
+            }
+            ShmFrame copy = *frame;
+            serve_frame(*predictor, *channels[c], copy, completion);
+            header->submit.pop();
+            header->complete.push(completion);
+            busy = true;
+        }
+        if (busy) {
+            idle = 0;
+        } else if (++idle < 1000) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 7) {
+        INFO("Please enter the correct parameters.");
+        INFO("For example:");
+        INFO("  rt-detr_shm_server [model path] [lable path] [device] [post flag(1/0)] [slot MB] [channel] ...");
+        return 0;
+    }
+    bool post_flag;
+    std::istringstream(argv[4]) >> post_flag;
+    uint64_t slot_bytes = (uint64_t)(std::atof(argv[5]) * 1024 * 1024);
+    ModelSwapper swapper(ModelBundle::from_paths(argv[1], argv[2], post_flag), argv[3], PredictorOptions());
+
+    std::vector<std::unique_ptr<ShmChannel>> channels;
+    for (int i = 6; i < argc; ++i) {
+        channels.emplace_back(new ShmChannel());
+        channels.back()->create(argv[i], SHM_RING_SIZE, slot_bytes);
+        INFO("Serving channel " << ShmChannel::shm_name(argv[i]) << ".");
+    }
+    std::signal(SIGINT, on_signal);
+    std::signal(SIGTERM, on_signal);
+    std::signal(SIGHUP, on_reload);
+    serve(swapper, channels);
+    // Closing the channels clears `server_state` and unlinks them.
+    channels.clear();
+    INFO("The server stopped.");
+    return 0;
+}
@@ -0,0 +1,148 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  18:51:33
+// @Brief  : This is common class.
+// @File    : thread_budget.cpp
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : 
+
+#include "thread_budget.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "opencv2/opencv.hpp"
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+
+/**
+ * The function returns the logical cores this process may run on.
+ */
+std::vector<int> available_cores() {
+    std::vector<int> cores;
+#if defined(_WIN32)
+    DWORD_PTR process_mask = 0, system_mask = 0;
+    if (GetProcessAffinityMask(GetCurrentProcess(), &process_mask, &system_mask)) {
+        for (int i = 0; i < (int)sizeof(DWORD_PTR) * 8; ++i) {
+            if (process_mask & ((DWORD_PTR)1 << i)) {
+                cores.push_back(i);
+            }
+        }
+    }
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int i = 0; i < CPU_SETSIZE; ++i) {
+            if (CPU_ISSET(i, &set)) {
+                cores.push_back(i);
+            }
+        }
+    }
+#endif
+    if (cores.empty()) {
+        for (int i = 0; i < (int)std::max(1u, std::thread::hardware_concurrency()); ++i) {
+            cores.push_back(i);
+        }
+    }
+    return cores;
+}
+
+/**
+ * The function `plan_thread_budget` splits `cores` between the host and the inference. The fused
+ * preprocess is a single pass over the input, so the host gets a quarter of the cores (at least one)
+ * and the inference the rest, shared by one stream per pooled request. With a single core both run
+ * on it.
+ *
+ * @param cores The core budget, 0 or more than available for all available cores.
+ * @param num_requests The pooled infer requests, each gets its own stream if there are cores for it.
+ */
+ThreadBudget plan_thread_budget(int cores, int num_requests) {
+    std::vector<int> available = available_cores();
+    if (cores <= 0 || cores > (int)available.size()) {
+        cores = (int)available.size();
+    }
+    ThreadBudget budget;
+    budget.host_threads = cores < 2 ? 1 : std::min(std::max(1, (cores + 2) / 4), cores - 1);
+    budget.infer_threads = cores < 2 ? 1 : cores - budget.host_threads;
+    budget.streams = std::max(1, std::min(num_requests, budget.infer_threads));
+    // The host takes the last cores of the budget, the inference threads are left to the scheduler.
+    budget.host_cores.assign(available.begin() + (cores - budget.host_threads), available.begin() + cores);
+    return budget;
+}
+
+#if defined(_WIN32) || defined(__linux__)
+/**
+ * The function pins the calling thread to the given cores.
+ */
+static void pin_current_thread(const std::vector<int>& cores) {
+#if defined(_WIN32)
+    DWORD_PTR mask = 0;
+    for (int core : cores) {
+        mask |= (DWORD_PTR)1 << core;
+    }
+    SetThreadAffinityMask(GetCurrentThread(), mask);
+#else
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int core : cores) {
+        CPU_SET(core, &set);
+    }
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+}
+#endif
+
+/**
+ * The function `apply_host_budget` sizes the OpenCV thread pool, which runs the fused preprocess, to
+ * `host_threads`, and optionally pins its workers to `host_cores`, one core each. OpenCV has no
+ * affinity API, so every worker pins itself inside a parallel_for_ whose stripes wait for each other,
+ * which spreads them over distinct threads; the calling thread gets its affinity back. The setting
+ * is process wide. A TBB or OpenMP build of OpenCV may not keep the same workers, then the pinning
+ * is best effort.
+ */
+void apply_host_budget(const ThreadBudget& budget, bool pin) {
+    cv::setNumThreads(budget.host_threads);
+#if defined(_WIN32) || defined(__linux__)
+    if (!pin || budget.host_cores.empty()) {
+        return;
+    }
+    std::thread::id caller = std::this_thread::get_id();
+    std::atomic<int> started(0);
+    const int stripes = budget.host_threads;
+    cv::parallel_for_(cv::Range(0, stripes), [&](const cv::Range& range) {
+        for (int i = range.start; i < range.end; ++i) {
+            if (std::this_thread::get_id() != caller) {
+                pin_current_thread({ budget.host_cores[i % budget.host_cores.size()] });
+            }
+            ++started;
+            auto timeout = std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
+            while (started.load() < stripes && std::chrono::steady_clock::now() < timeout) {
+                std::this_thread::yield();
+            }
+        }
+    }, stripes);
+#endif
+}
+
+/**
+ * The function `add_infer_budget` adds the inference share of the budget to the CPU compile config:
+ * the thread count and one stream per pooled request. The plugin's own core pinning is turned off:
+ * it picks its cores without regard to `host_cores`, so it would pin streams onto the cores of the
+ * pinned host threads.
+ */
+void add_infer_budget(const ThreadBudget& budget, ov::AnyMap& config) {
+    config.insert(ov::inference_num_threads(budget.infer_threads));
+    config.insert(ov::num_streams(budget.streams));
+    config.insert(ov::hint::enable_cpu_pinning(false));
+}
@@ -0,0 +1,36 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  18:42:15
+// @Brief  : This is common class.
+// @File    : thread_budget.h
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : Splits a CPU core budget between the host pre/postprocessing workers (the OpenCV
+//                thread pool) and the OpenVINO CPU streams, so the two pools stop oversubscribing
+//                the machine.
+#ifndef __THREAD_BUDGET_H__
+#define __THREAD_BUDGET_H__
+
+#include <vector>
+
+#include "openvino/openvino.hpp"
+
+struct ThreadBudget {
+    int host_threads;               // The OpenCV threads of the fused preprocess.
+    int infer_threads;              // The OpenVINO CPU inference threads.
+    int streams;                    // The OpenVINO CPU streams, one per pooled request.
+    std::vector<int> host_cores;    // The cores the host threads are pinned to.
+    ThreadBudget() : host_threads(0), infer_threads(0), streams(0) {}
+};
+
+std::vector<int> available_cores();
+
+ThreadBudget plan_thread_budget(int cores, int num_requests);
+
+void apply_host_budget(const ThreadBudget& budget, bool pin);
+
+void add_infer_budget(const ThreadBudget& budget, ov::AnyMap& config);
+
+#endif // !__THREAD_BUDGET_H__
@@ -0,0 +1,78 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  15:24:09
+// @Brief  : This is common class.
+// @File    : thread_pool.cpp
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : 
+
+#include "thread_pool.h"
+
+
+/**
+ * The ThreadPool constructor starts the worker threads.
+ *
+ * @param threads The number of worker threads, at least 1.
+ * @param max_queue The number of tasks that may wait for a worker.
+ */
+ThreadPool::ThreadPool(int threads, size_t max_queue)
+    : max_queue(max_queue), stopping(false) {
+    for (int i = 0; i < (threads > 0 ? threads : 1); ++i) {
+        workers.emplace_back(&ThreadPool::run, this);
+    }
+}
+
+/**
+ * The destructor lets the workers finish the queued tasks, then joins them.
+ */
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    cond.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+/**
+ * The function `try_submit` queues a task without blocking.
+ *
+ * @return false if the queue is full, the caller should shed the work.
+ */
+bool ThreadPool::try_submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping || tasks.size() >= max_queue) {
+            return false;
+        }
+        tasks.push_back(std::move(task));
+    }
+    cond.notify_one();
+    return true;
+}
+
+size_t ThreadPool::queue_depth() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return tasks.size();
+}
+
+void ThreadPool::run() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cond.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
@@ -0,0 +1,45 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  15:20:44
+// @Brief  : This is common class.
+// @File    : thread_pool.h
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : 
+#ifndef __THREAD_POOL_H__
+#define __THREAD_POOL_H__
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A fixed pool of worker threads with a bounded task queue.
+class ThreadPool
+{
+public:
+    ThreadPool(int threads, size_t max_queue);
+    ~ThreadPool();
+    bool try_submit(std::function<void()> task);
+    size_t queue_depth();
+    int get_threads() { return (int)workers.size(); }
+
+private:
+    ThreadPool(const ThreadPool&);
+    ThreadPool& operator=(const ThreadPool&);
+    void run();
+
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    size_t max_queue;           // The tasks waiting for a worker, `try_submit` fails beyond it.
+    std::mutex mutex;
+    std::condition_variable cond;
+    bool stopping;
+};
+
+#endif // !__THREAD_POOL_H__
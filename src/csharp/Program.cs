@@ -14,14 +14,22 @@ namespace rt_detr_openvino_csharp
 {
     internal class Program
     {
-        static void RT_DETR(string model_path, string image_path, string label_path, bool post_flag)
+        static void RT_DETR(string model_path, string image_path, string label_path, bool post_flag, bool native_flag)
         {
             INFO("Hello, World!");
             //string image_path = "E:\\GitSpace\\RT-DETR-OpenVINO\\image\\000000570688.jpg";
             //string label_path = "E:\\GitSpace\\RT-DETR-OpenVINO\\image\\COCO_lable.txt";
             Mat image = Cv2.ImRead(image_path);
             Mat result_mat = new Mat();
-            if (post_flag)
+            if (native_flag)
+            {
+                // The C++ predictor through the rtdetr_c library, with its fused preprocess.
+                using (RTDETRNativePredictor predictor = new RTDETRNativePredictor(model_path, label_path, "CPU", post_flag))
+                {
+                    result_mat = predictor.predict(image);
+                }
+            }
+            else if (post_flag)
             {
                 //  string model_path  = "E:\\Model\\rtdetr_r50vd_6x_coco.onnx";
                 RTDETRPredictor predictor = new RTDETRPredictor(model_path, label_path, "CPU", true);
@@ -41,9 +49,10 @@ namespace rt_detr_openvino_csharp
             if (args.Length < 4) {
                 INFO("Please enter the correct parameters.");
                 INFO("For example:");
-                INFO("  dotnet run [model path] [image path] [lable path] [post flag(1/0)].");
+                INFO("  dotnet run [model path] [image path] [lable path] [post flag(1/0)] [native(0/1)].");
             }
-            RT_DETR(args[0], args[1], args[2], Convert.ToBoolean(Convert.ToInt32(args[3])));
+            bool native_flag = args.Length > 4 && Convert.ToInt32(args[4]) != 0;
+            RT_DETR(args[0], args[1], args[2], Convert.ToBoolean(Convert.ToInt32(args[3])), native_flag);
         }
     }
 }
\ No newline at end of file
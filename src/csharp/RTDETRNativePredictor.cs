@@ -0,0 +1,262 @@
+﻿// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  23:47:15
+// @Brief  : This is common class.
+// @File    : RTDETRNativePredictor.cs
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : The C++ predictor through the C interface of the `rtdetr_c` library (rtdetr_c.dll or
+//                librtdetr_c.so, next to the executable or on the library path). The image buffer of a
+//                Mat is passed as is, the preprocess reads it in place.
+using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+using System.Text;
+using OpenCvSharp;
+using static rt_detr_openvino_csharp.Msg;
+
+namespace rt_detr_openvino_csharp
+{
+    /// <summary>
+    /// The layout of `rtdetr_detection`.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct NativeDetection
+    {
+        public int clsid;
+        public float score;
+        public float x;
+        public float y;
+        public float width;
+        public float height;
+    }
+
+    /// <summary>
+    /// The layout of `rtdetr_options`.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct NativeOptions
+    {
+        public int num_requests;
+        public int cpu_threads;
+        public int warmup_iterations;
+        public int low_memory;
+    }
+
+    /// <summary>
+    /// The pixel formats of `rtdetr_detect`.
+    /// </summary>
+    public enum NativePixelFormat
+    {
+        BGR = 0,
+        RGB = 1,
+        BGRA = 2,
+        RGBA = 3,
+        GRAY = 4,
+        NV12 = 5,
+        NV21 = 6,
+        I420 = 7,
+    }
+
+    internal static class NativeMethods
+    {
+        const string dll_name = "rtdetr_c";
+
+        [DllImport(dll_name, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void rtdetr_default_options(ref NativeOptions options);
+
+        [DllImport(dll_name, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int rtdetr_create(byte[]? model_path, byte[]? label_path, byte[]? device_name,
+            int post_flag, ref NativeOptions options, out IntPtr predictor);
+
+        [DllImport(dll_name, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int rtdetr_create_from_bundle(byte[]? bundle_path, byte[]? device_name,
+            ref NativeOptions options, out IntPtr predictor);
+
+        [DllImport(dll_name, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void rtdetr_destroy(IntPtr predictor);
+
+        [DllImport(dll_name, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int rtdetr_detect(IntPtr predictor, IntPtr data, int width, int height, int stride,
+            int format, [Out] NativeDetection[] detections, int capacity, out int count);
+
+        [DllImport(dll_name, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int rtdetr_detect_encoded(IntPtr predictor, byte[] data, UIntPtr size,
+            [Out] NativeDetection[] detections, int capacity, out int count);
+
+        [DllImport(dll_name, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int rtdetr_get_label(IntPtr predictor, int clsid, byte[] buffer, int size);
+
+        [DllImport(dll_name, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr rtdetr_last_error();
+    }
+
+    public class RTDETRNativePredictor : IDisposable
+    {
+        /// <summary>
+        /// The RTDETRNativePredictor function loads and compiles the model in the C++ predictor.
+        /// </summary>
+        /// <param name="model_path">The path to the model file.</param>
+        /// <param name="label_path">The path to the label file, null for none.</param>
+        /// <param name="device_name">The device, e.g. "CPU" or "GPU.0".</param>
+        /// <param name="postprcoess">Whether the model includes the post-processing layers.</param>
+        /// <param name="num_requests">The infer requests of the pool.</param>
+        /// <param name="low_memory">Whether the predictor is set up for a memory-constrained device.</param>
+        public RTDETRNativePredictor(string model_path, string? label_path, string device_name = "CPU",
+            bool postprcoess = true, int num_requests = 1, bool low_memory = false)
+        {
+            INFO("Model path: " + model_path);
+            INFO("Device name: " + device_name);
+            NativeOptions options = new NativeOptions();
+            NativeMethods.rtdetr_default_options(ref options);
+            options.num_requests = num_requests;
+            options.low_memory = low_memory ? 1 : 0;
+            check(NativeMethods.rtdetr_create(to_utf8(model_path), to_utf8(label_path), to_utf8(device_name),
+                postprcoess ? 1 : 0, ref options, out predictor));
+        }
+
+        /// <summary>
+        /// The function loads a model bundle, a directory with a `bundle.json` manifest.
+        /// </summary>
+        /// <param name="bundle_path">The bundle directory or its manifest.</param>
+        /// <param name="device_name">The device, e.g. "CPU" or "GPU.0".</param>
+        public static RTDETRNativePredictor from_bundle(string bundle_path, string device_name = "CPU")
+        {
+            NativeOptions options = new NativeOptions();
+            NativeMethods.rtdetr_default_options(ref options);
+            IntPtr handle;
+            check(NativeMethods.rtdetr_create_from_bundle(to_utf8(bundle_path), to_utf8(device_name),
+                ref options, out handle));
+            return new RTDETRNativePredictor(handle);
+        }
+
+        private RTDETRNativePredictor(IntPtr handle)
+        {
+            predictor = handle;
+        }
+
+        /// <summary>
+        /// The function detects the objects in an image and returns the image with the boxes drawn.
+        /// </summary>
+        public Mat predict(Mat image)
+        {
+            return draw_process.draw_box(image, detect(image));
+        }
+
+        /// <summary>
+        /// The function detects the objects in a BGR, BGRA or GRAY Mat. The Mat data is read in place.
+        /// </summary>
+        /// <returns>The detections, with the labels of the label file.</returns>
+        public ResultData detect(Mat image)
+        {
+            NativePixelFormat format = image.Channels() == 1 ? NativePixelFormat.GRAY :
+                image.Channels() == 4 ? NativePixelFormat.BGRA : NativePixelFormat.BGR;
+            int count = detect(image.Data, image.Cols, image.Rows, (int)image.Step(), format);
+            return to_result(count);
+        }
+
+        /// <summary>
+        /// The function detects the objects in a caller-owned image buffer, which only has to stay valid
+        /// during the call. The chroma planes of a YUV image follow the Y plane.
+        /// </summary>
+        /// <returns>The number of detections, see `get_detections`.</returns>
+        public int detect(IntPtr data, int width, int height, int stride, NativePixelFormat format)
+        {
+            int count;
+            check(NativeMethods.rtdetr_detect(predictor, data, width, height, stride, (int)format,
+                detections, detections.Length, out count));
+            return reserve(count);
+        }
+
+        /// <summary>
+        /// The function detects the objects in an encoded image (JPEG, PNG, ...).
+        /// </summary>
+        public ResultData detect_encoded(byte[] data)
+        {
+            int count;
+            check(NativeMethods.rtdetr_detect_encoded(predictor, data, (UIntPtr)data.Length,
+                detections, detections.Length, out count));
+            return to_result(reserve(count));
+        }
+
+        /// <summary>
+        /// The detections of the last call, valid up to the count it returned.
+        /// </summary>
+        public NativeDetection[] get_detections() { return detections; }
+
+        public string get_label(int clsid)
+        {
+            if (!labels.TryGetValue(clsid, out string? label))
+            {
+                byte[] buffer = new byte[256];
+                int length = NativeMethods.rtdetr_get_label(predictor, clsid, buffer, buffer.Length);
+                label = length > 0 ? Encoding.UTF8.GetString(buffer, 0, Math.Min(length, buffer.Length - 1)) :
+                    clsid.ToString();
+                labels[clsid] = label;
+            }
+            return label;
+        }
+
+        public void Dispose()
+        {
+            if (predictor != IntPtr.Zero)
+            {
+                NativeMethods.rtdetr_destroy(predictor);
+                predictor = IntPtr.Zero;
+            }
+            GC.SuppressFinalize(this);
+        }
+
+        ~RTDETRNativePredictor()
+        {
+            Dispose();
+        }
+
+        /// <summary>
+        /// The function grows the detection array when a result did not fit, the detections beyond the
+        /// array are left out of this result only. The detections that fitted are kept in the grown array.
+        /// </summary>
+        private int reserve(int count)
+        {
+            if (count > detections.Length)
+            {
+                int fitted = detections.Length;
+                Array.Resize(ref detections, count);
+                return fitted;
+            }
+            return count;
+        }
+
+        private ResultData to_result(int count)
+        {
+            ResultData result = new ResultData();
+            for (int i = 0; i < count; ++i)
+            {
+                NativeDetection d = detections[i];
+                result.add_data(d.clsid, get_label(d.clsid),
+                    new Rect((int)d.x, (int)d.y, (int)d.width, (int)d.height), d.score);
+            }
+            return result;
+        }
+
+        private static byte[]? to_utf8(string? text)
+        {
+            return text == null ? null : Encoding.UTF8.GetBytes(text + "\0");
+        }
+
+        private static void check(int status)
+        {
+            if (status != 0)
+            {
+                throw new InvalidOperationException(Marshal.PtrToStringUTF8(NativeMethods.rtdetr_last_error()));
+            }
+        }
+
+        IntPtr predictor;
+        NativeDetection[] detections = new NativeDetection[300];
+        Dictionary<int, string> labels = new Dictionary<int, string>();
+        RTDETRProcess draw_process = new RTDETRProcess();
+    }
+}
@@ -10,13 +10,30 @@ import sys
 from process import print_info
 from openvino_deploy_rtdetr import rtdert_infer
 
-def main(model_path, image_path, lable_path, postprocess = True):
+def native_infer(model_path, image_path, lable_path, postprocess = True):
+    """
+    The `native_infer` function runs the C++ predictor through the rtdetr_c library on an image, the
+    image array is passed to it without a copy.
+    """
+    import cv2 as cv
+    from process import RtdetrProcess
+    from rtdetr_native import NativePredictor
+    predictor = NativePredictor(model_path, lable_path, "CPU", postprocess)
+    image = cv.imread(image_path)
+    results = predictor.detect(image)
+    new_image = RtdetrProcess([640,640]).draw_box(image, results)
+    cv.imshow("Python deploy RT-DETR result", new_image)
+    cv.waitKey(0)
+
+def main(model_path, image_path, lable_path, postprocess = True, native = False):
     """
     The main function prints a greeting message, sets the paths for a model, an image, and a label file,
     and then calls the rtdert_infer function with these paths and some additional parameters.
     """
     print_info("This is an RT-DETR model deployment case using Python!")
-    if(postprocess):
+    if(native):
+        native_infer(model_path, image_path, lable_path, postprocess)
+    elif(postprocess):
         # model_path = "E:\\Model\\rtdetr_r50vd_6x_coco.onnx"
         # image_path = "E:\\GitSpace\\RT-DETR-OpenVINO\\image\\000000570688.jpg"
         # lable_path = "E:\\GitSpace\\OpenVINO-CSharp-API\dataset\\lable\\COCO_lable.txt"
@@ -34,7 +51,7 @@ if __name__ == '__main__':
     if (len(sys.argv) < 5) :
         print_info("Please enter the correct parameters.")
         print_info("For example:")
-        print_info("  python main.py [model path] [image path] [lable path] [post flag(1/0)].")
+        print_info("  python main.py [model path] [image path] [lable path] [post flag(1/0)] [native(0/1)].")
     else:
         b=False
         if sys.argv[4] == "0":
@@ -42,4 +59,5 @@ if __name__ == '__main__':
         elif sys.argv[4] == "1":
             b=True
         
-        main(sys.argv[1],sys.argv[2],sys.argv[3],b)
\ No newline at end of file
+        native = len(sys.argv) > 5 and sys.argv[5] == "1"
+        main(sys.argv[1],sys.argv[2],sys.argv[3],b,native)
\ No newline at end of file
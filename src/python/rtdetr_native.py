@@ -0,0 +1,234 @@
+# !/usr/bin/env python
+# -*- coding: utf-8 -*-
+# @Time    : 2026/10/19  23:58:26
+# @Author  : Yan Guojin
+# @File    : rtdetr_native.py
+# @E-mail	: guojin_yjs@cumt.edu.cn
+# @GitHub	: https://github.com/guojin-yan
+# @Description : The C++ predictor through the C interface of the `rtdetr_c` library. The library is
+#                looked up in RTDETR_C_LIBRARY, next to this file, then on the library path.
+
+import ctypes
+import ctypes.util
+import os
+import sys
+
+import numpy as np
+
+RTDETR_OK = 0
+
+# The pixel formats of `rtdetr_detect`.
+FORMAT_BGR = 0
+FORMAT_RGB = 1
+FORMAT_BGRA = 2
+FORMAT_RGBA = 3
+FORMAT_GRAY = 4
+FORMAT_NV12 = 5
+FORMAT_NV21 = 6
+FORMAT_I420 = 7
+
+# The layout of `rtdetr_detection`, the detections are written straight into an array of this type.
+DETECTION_DTYPE = np.dtype([("clsid", np.int32), ("score", np.float32), ("x", np.float32),
+                            ("y", np.float32), ("width", np.float32), ("height", np.float32)])
+
+
+class _Options(ctypes.Structure):
+    _fields_ = [("num_requests", ctypes.c_int32), ("cpu_threads", ctypes.c_int32),
+                ("warmup_iterations", ctypes.c_int32), ("low_memory", ctypes.c_int32)]
+
+
+def _library_names():
+    if sys.platform == "win32":
+        return ["rtdetr_c.dll"]
+    if sys.platform == "darwin":
+        return ["librtdetr_c.dylib"]
+    return ["librtdetr_c.so"]
+
+
+def load_library(path=None):
+    """
+    The `load_library` function loads the `rtdetr_c` library and declares the signatures of its
+    functions.
+
+    Args:
+      path: The library file, None to search RTDETR_C_LIBRARY, the directory of this file and the
+    library path.
+
+    Returns:
+      the ctypes.CDLL object.
+    """
+    candidates = [path] if path else []
+    if os.environ.get("RTDETR_C_LIBRARY"):
+        candidates.append(os.environ["RTDETR_C_LIBRARY"])
+    here = os.path.dirname(os.path.abspath(__file__))
+    candidates += [os.path.join(here, name) for name in _library_names()]
+    found = ctypes.util.find_library("rtdetr_c")
+    if found:
+        candidates.append(found)
+    lib = None
+    for candidate in candidates:
+        if os.path.exists(candidate) or candidate == found:
+            lib = ctypes.CDLL(candidate)
+            break
+    if lib is None:
+        raise OSError("The rtdetr_c library was not found, set RTDETR_C_LIBRARY to its path.")
+
+    handle = ctypes.c_void_p
+    detections = np.ctypeslib.ndpointer(dtype=DETECTION_DTYPE, flags="C_CONTIGUOUS")
+    i32 = ctypes.c_int32
+    lib.rtdetr_default_options.argtypes = [ctypes.POINTER(_Options)]
+    lib.rtdetr_default_options.restype = None
+    lib.rtdetr_create.argtypes = [ctypes.c_char_p, ctypes.c_char_p, ctypes.c_char_p, i32,
+                                  ctypes.POINTER(_Options), ctypes.POINTER(handle)]
+    lib.rtdetr_create.restype = i32
+    lib.rtdetr_create_from_bundle.argtypes = [ctypes.c_char_p, ctypes.c_char_p, ctypes.POINTER(_Options),
+                                              ctypes.POINTER(handle)]
+    lib.rtdetr_create_from_bundle.restype = i32
+    lib.rtdetr_destroy.argtypes = [handle]
+    lib.rtdetr_destroy.restype = None
+    lib.rtdetr_detect.argtypes = [handle, ctypes.c_void_p, i32, i32, i32, i32, detections, i32,
+                                  ctypes.POINTER(i32)]
+    lib.rtdetr_detect.restype = i32
+    lib.rtdetr_detect_encoded.argtypes = [handle, ctypes.c_void_p, ctypes.c_size_t, detections, i32,
+                                          ctypes.POINTER(i32)]
+    lib.rtdetr_detect_encoded.restype = i32
+    lib.rtdetr_get_input_size.argtypes = [handle, ctypes.POINTER(i32), ctypes.POINTER(i32)]
+    lib.rtdetr_get_input_size.restype = i32
+    lib.rtdetr_get_label.argtypes = [handle, i32, ctypes.c_char_p, i32]
+    lib.rtdetr_get_label.restype = i32
+    lib.rtdetr_last_error.argtypes = []
+    lib.rtdetr_last_error.restype = ctypes.c_char_p
+    return lib
+
+
+def _encode(text):
+    return None if text is None else text.encode("utf-8")
+
+
+class NativePredictor(object):
+    def __init__(self, model_path, label_path=None, device_name="CPU", postprocess=True,
+                 num_requests=1, low_memory=False, bundle_path=None, library=None):
+        """
+        This function loads and compiles the model in the C++ predictor.
+
+        Args:
+          model_path: The path to the model file, ignored with `bundle_path`.
+          label_path: The path to the label file, None for none.
+          device_name: The device, e.g. "CPU" or "GPU.0".
+          postprocess: Whether the model includes the post-processing layers.
+          num_requests: The infer requests of the pool.
+          low_memory: Whether the predictor is set up for a memory-constrained device.
+          bundle_path: A model bundle directory or manifest, instead of the model and label files.
+          library: The path of the rtdetr_c library, see `load_library`.
+        """
+        self.lib = load_library(library)
+        self.handle = ctypes.c_void_p()
+        options = _Options()
+        self.lib.rtdetr_default_options(ctypes.byref(options))
+        options.num_requests = num_requests
+        options.low_memory = 1 if low_memory else 0
+        if bundle_path is not None:
+            status = self.lib.rtdetr_create_from_bundle(_encode(bundle_path), _encode(device_name),
+                                                        ctypes.byref(options), ctypes.byref(self.handle))
+        else:
+            status = self.lib.rtdetr_create(_encode(model_path), _encode(label_path), _encode(device_name),
+                                            1 if postprocess else 0, ctypes.byref(options),
+                                            ctypes.byref(self.handle))
+        self._check(status)
+        self.detections = np.zeros(300, dtype=DETECTION_DTYPE)
+        self.labels = dict()
+
+    def __del__(self):
+        self.close()
+
+    def close(self):
+        if getattr(self, "handle", None):
+            self.lib.rtdetr_destroy(self.handle)
+            self.handle = None
+
+    def _check(self, status):
+        if status != RTDETR_OK:
+            raise RuntimeError(self.lib.rtdetr_last_error().decode("utf-8", "replace"))
+
+    def _take(self, count):
+        """
+        The function returns the detections of the last call, and grows the array when they did not all
+        fit; the detections beyond the array are left out of this result only.
+        """
+        fitted = min(count, len(self.detections))
+        result = self.detections[:fitted].copy()
+        if count > len(self.detections):
+            self.detections = np.zeros(count, dtype=DETECTION_DTYPE)
+        return result
+
+    def detect_array(self, image, pixel_format=None):
+        """
+        The `detect_array` function detects the objects in an 8-bit image array, which is read in place:
+        only the rows may be padded, the pixels of a row must be contiguous.
+
+        Args:
+          image: A HxWx3 (BGR), HxWx4 (BGRA) or HxW (GRAY) uint8 array, or a (H*3/2)xW array of an NV12,
+        NV21 or I420 frame.
+          pixel_format: One of the FORMAT_* values, None to derive it from the shape.
+
+        Returns:
+          a structured array of DETECTION_DTYPE, the boxes in pixels of the image.
+        """
+        if image.dtype != np.uint8:
+            raise ValueError("The image must be uint8.")
+        channels = 1 if image.ndim == 2 else image.shape[2]
+        if pixel_format is None:
+            pixel_format = {1: FORMAT_GRAY, 3: FORMAT_BGR, 4: FORMAT_BGRA}[channels]
+        if (image.strides[0] < image.shape[1] * channels or image.strides[1] != channels or
+                (image.ndim == 3 and image.strides[2] != 1)):
+            image = np.ascontiguousarray(image)
+        height = image.shape[0]
+        if pixel_format in (FORMAT_NV12, FORMAT_NV21, FORMAT_I420):
+            height = height * 2 // 3
+        count = ctypes.c_int32(0)
+        self._check(self.lib.rtdetr_detect(self.handle, image.ctypes.data, image.shape[1], height,
+                                           image.strides[0], pixel_format, self.detections,
+                                           len(self.detections), ctypes.byref(count)))
+        return self._take(count.value)
+
+    def detect_encoded(self, data):
+        """
+        The `detect_encoded` function detects the objects in an encoded image (JPEG, PNG, ...).
+
+        Args:
+          data: The bytes of the encoded image.
+        """
+        buffer = np.frombuffer(data, dtype=np.uint8)
+        count = ctypes.c_int32(0)
+        self._check(self.lib.rtdetr_detect_encoded(self.handle, buffer.ctypes.data, buffer.size,
+                                                   self.detections, len(self.detections),
+                                                   ctypes.byref(count)))
+        return self._take(count.value)
+
+    def get_label(self, clsid):
+        if clsid not in self.labels:
+            buffer = ctypes.create_string_buffer(256)
+            length = self.lib.rtdetr_get_label(self.handle, clsid, buffer, len(buffer))
+            self.labels[clsid] = buffer.value.decode("utf-8", "replace") if length > 0 else clsid
+        return self.labels[clsid]
+
+    def get_input_size(self):
+        width, height = ctypes.c_int32(0), ctypes.c_int32(0)
+        self._check(self.lib.rtdetr_get_input_size(self.handle, ctypes.byref(width), ctypes.byref(height)))
+        return width.value, height.value
+
+    def detect(self, image):
+        """
+        The `detect` function detects the objects in a BGR image and returns them in the format of
+        `RtdetrProcess.postprocess`, so that `RtdetrProcess.draw_box` can draw them.
+
+        Returns:
+          a list of dictionaries with the keys `clsid`, `label`, `score` and `bbox` ([x1, y1, x2, y2]).
+        """
+        results = []
+        for d in self.detect_array(image):
+            clsid = int(d["clsid"])
+            results.append({"clsid": clsid, "label": self.get_label(clsid), "score": float(d["score"]),
+                            "bbox": [float(d["x"]), float(d["y"]), float(d["x"] + d["width"]),
+                                     float(d["y"] + d["height"])]})
+        return results
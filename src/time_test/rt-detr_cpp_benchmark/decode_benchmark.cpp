@@ -0,0 +1,115 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  16:55:08
+// @Brief  : This is the decode benchmark.
+// @File    : decode_benchmark.cpp
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : Times the ingestion of encoded images up to the 640x640 input blob: a full size
+//                decode (what cv::imread does) against the DCT-scaled decode, one image at a time and
+//                as a batch on the parallel decode pool. The inputs are the repository sample images
+//                and synthetic 4K/12MP/8K JPEGs.
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "opencv2/opencv.hpp"
+#include "image_decoder.h"
+#include "image_input.h"
+
+
+/**
+ * The function encodes a synthetic photo-like JPEG: smooth gradients, sharp edged blocks and sensor
+ * noise, so the entropy decoding cost is realistic.
+ */
+static std::vector<uint8_t> make_jpeg(int width, int height) {
+    cv::Mat image(height, width, CV_8UC3);
+    cv::RNG rng(2023);
+    for (int y = 0; y < height; ++y) {
+        uint8_t* row = image.ptr<uint8_t>(y);
+        for (int x = 0; x < width; ++x) {
+            row[x * 3] = (uint8_t)(x * 255 / width);
+            row[x * 3 + 1] = (uint8_t)(y * 255 / height);
+            row[x * 3 + 2] = (uint8_t)(((x / 37 + y / 53) % 2) * 200 + rng.uniform(0, 40));
+        }
+    }
+    std::vector<uint8_t> data;
+    cv::imencode(".jpg", image, data, { cv::IMWRITE_JPEG_QUALITY, 90 });
+    return data;
+}
+
+static std::vector<uint8_t> read_file(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+/**
+ * The function returns the mean time of `f` over `iters` calls in milliseconds.
+ */
+static double time_ms(const std::function<void()>& f, int iters) {
+    auto t1 = std::chrono::steady_clock::now();
+    for (int i = 0; i < iters; ++i) {
+        f();
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t2 - t1).count() / iters;
+}
+
+int main(int argc, char* argv[]) {
+    const cv::Size input_size(640, 640);
+    const std::string image_dir = argc > 1 ? argv[1] : "../../../image";
+    struct Input { std::string name; std::vector<uint8_t> data; };
+    std::vector<Input> inputs;
+    for (const char* name : { "000000570688.jpg", "000000014439.jpg", "car.jpg" }) {
+        std::vector<uint8_t> data = read_file(image_dir + "/" + name);
+        if (!data.empty()) {
+            inputs.push_back({ name, data });
+        }
+    }
+    inputs.push_back({ "synthetic 3840x2160", make_jpeg(3840, 2160) });
+    inputs.push_back({ "synthetic 4000x3000", make_jpeg(4000, 3000) });
+    inputs.push_back({ "synthetic 7680x4320", make_jpeg(7680, 4320) });
+
+    std::vector<float> blob(3 * input_size.area());
+    std::printf("%-22s %11s %6s %11s %16s %16s\n", "image", "size", "scale", "decoded", "full (ms)",
+        "scaled (ms)");
+    for (const Input& input : inputs) {
+        DecodedImage image;
+        int iters = input.data.size() > (1 << 20) ? 10 : 50;
+        // imread + blob: the path `detect(cv::Mat)` takes for a file.
+        double t_full = time_ms([&] {
+            cv::Mat mat = cv::imdecode(input.data, cv::IMREAD_COLOR);
+            blob_from_image(ImageView::from_mat(mat), input_size, blob.data());
+        }, iters);
+        double t_scaled = time_ms([&] {
+            decode_image(input.data.data(), input.data.size(), input_size, image);
+            blob_from_image(image.view(), input_size, blob.data());
+        }, iters);
+        std::printf("%-22s %5dx%-5d %4d %5dx%-5d %16.2f %16.2f\n", input.name.c_str(), image.full_width,
+            image.full_height, image.scale_denom, image.pixels.cols, image.pixels.rows, t_full, t_scaled);
+    }
+
+    // A batch pipeline: 32 encoded 4K frames decoded serially versus on the parallel decode pool.
+    std::vector<std::vector<uint8_t>> files(32, make_jpeg(3840, 2160));
+    std::vector<DecodedImage> images;
+    double t_serial = time_ms([&] {
+        for (const std::vector<uint8_t>& file : files) {
+            DecodedImage image;
+            decode_image(file.data(), file.size(), input_size, image);
+        }
+    }, 3);
+    double t_parallel = time_ms([&] { decode_images(files, input_size, images); }, 3);
+    double t_parallel_full = time_ms([&] { decode_images(files, input_size, images, false); }, 3);
+    std::printf("\nbatch of %zu 4K JPEGs, %d threads (ms per image)\n", files.size(), cv::getNumThreads());
+    std::printf("  scaled, serial      %8.2f\n", t_serial / files.size());
+    std::printf("  scaled, parallel    %8.2f\n", t_parallel / files.size());
+    std::printf("  full, parallel      %8.2f\n", t_parallel_full / files.size());
+    return 0;
+}
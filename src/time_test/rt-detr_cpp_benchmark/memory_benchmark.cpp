@@ -0,0 +1,101 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  22:41:19
+// @Brief  : This is the memory benchmark.
+// @File    : memory_benchmark.cpp
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : Measures the resident memory of the predictor for the default and the low-memory
+//                configurations. Every configuration runs in a fresh process, since freed memory is
+//                not reliably given back to the system and would blur the next measurement.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "opencv2/opencv.hpp"
+#include "rtdert_predictor.h"
+
+
+struct MemoryConfig {
+    const char* name;
+    int num_requests;
+    bool low_memory;
+    ov::element::Type precision;
+};
+
+static const int NUM_CONFIGS = 5;
+
+static MemoryConfig get_config(int index) {
+    MemoryConfig configs[NUM_CONFIGS] = {
+        { "default", 4, false, ov::element::undefined },
+        { "default", 1, false, ov::element::undefined },
+        { "low-mem", 1, true, ov::element::undefined },
+        { "low-f16", 1, true, ov::element::f16 },
+        { "low-bf16", 1, true, ov::element::bf16 },
+    };
+    return configs[index];
+}
+
+static double to_mb(double bytes) {
+    return bytes / (1024.0 * 1024.0);
+}
+
+/**
+ * The function loads the predictor of one configuration, runs `rounds` detections and prints one row.
+ */
+static int run_config(int index, const char* model_path, const char* label_path, bool post_flag, int rounds) {
+    MemoryConfig config = get_config(index);
+    PredictorOptions options = config.low_memory ? PredictorOptions::low_memory(config.precision) :
+        PredictorOptions();
+    options.num_requests = config.num_requests;
+    RTDETRPredictor predictor(model_path, label_path, "CPU", post_flag, options);
+    MemoryStats loaded = predictor.get_memory_stats();
+
+    cv::Mat image(1080, 1920, CV_8UC3);
+    cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(255));
+    ImageView view = ImageView::from_mat(image);
+    auto t1 = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; ++i) {
+        predictor.detect(view);
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t1).count() /
+        std::max(rounds, 1);
+    MemoryStats after = predictor.get_memory_stats();
+    std::printf("%-9s %4d %9.1f %9.1f %9.1f %9.1f %9.1f %9.1f %9.1f %9.1f %9.1f %8.2f\n", config.name,
+        predictor.get_num_requests(), to_mb(loaded.weight_bytes), to_mb(loaded.model_rss),
+        to_mb(loaded.compile_rss), to_mb(loaded.warmup_rss), to_mb(loaded.released_rss),
+        to_mb(loaded.tensor_bytes), to_mb(loaded.rss), to_mb(after.rss), to_mb(after.peak_rss), ms);
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::printf("Usage: memory_benchmark [model path] [lable path] [post flag(1/0)] [rounds(20)]\n");
+        return 0;
+    }
+    bool post_flag = argc > 3 ? std::atoi(argv[3]) != 0 : true;
+    int rounds = argc > 4 ? std::atoi(argv[4]) : 20;
+    // A child process measures one configuration.
+    if (argc > 6 && std::strcmp(argv[5], "--config") == 0) {
+        return run_config(std::atoi(argv[6]), argv[1], argv[2], post_flag, rounds);
+    }
+    std::printf("%-9s %4s %9s %9s %9s %9s %9s %9s %9s %9s %9s %8s\n", "config", "reqs", "weights",
+        "+read", "+compile", "+warmup", "-release", "tensors", "rss", "rss run", "peak", "ms");
+    std::fflush(stdout);
+    for (int i = 0; i < NUM_CONFIGS; ++i) {
+        std::string command = std::string("\"") + argv[0] + "\" \"" + argv[1] + "\" \"" + argv[2] + "\" " +
+            (post_flag ? "1" : "0") + " " + std::to_string(rounds) + " --config " + std::to_string(i);
+        if (std::system(command.c_str()) != 0) {
+            std::printf("%-9s failed\n", get_config(i).name);
+        }
+        std::fflush(stdout);
+    }
+    std::printf("All sizes in MB, the +/- columns are the RSS growth of each loading step.\n");
+    return 0;
+}
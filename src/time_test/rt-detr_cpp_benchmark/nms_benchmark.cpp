@@ -0,0 +1,94 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  11:40:26
+// @Brief  : This is the NMS benchmark.
+// @File    : nms_benchmark.cpp
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : Times the host-side NMS stage on 300 to 10k synthetic candidates, the way a low
+//                threshold on the raw head model produces them: clusters of jittered duplicates.
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "nms.h"
+
+
+/**
+ * The function builds `count` candidates in a 1920x1080 frame, as clusters of 1 to 8 jittered
+ * duplicates of random objects over 80 classes.
+ */
+static BoxSet make_candidates(int count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> pos_x(0.0f, 1800.0f), pos_y(0.0f, 1000.0f);
+    std::uniform_real_distribution<float> size(16.0f, 200.0f), jitter(-6.0f, 6.0f), score(0.05f, 0.95f);
+    std::uniform_int_distribution<int> dups(1, 8), cls(0, 79);
+    BoxSet boxes;
+    boxes.reserve(count);
+    while ((int)boxes.size() < count) {
+        float x = pos_x(rng), y = pos_y(rng), w = size(rng), h = size(rng);
+        int c = cls(rng);
+        for (int d = dups(rng); d > 0 && (int)boxes.size() < count; --d) {
+            float dx = jitter(rng), dy = jitter(rng);
+            boxes.push_back(x + dx, y + dy, x + w + dx + jitter(rng), y + h + dy + jitter(rng),
+                score(rng), c, (int)boxes.size());
+        }
+    }
+    return boxes;
+}
+
+/**
+ * The function runs the suppressor on a copy of `input` for `iters` iterations, and returns the mean
+ * time per call in microseconds.
+ */
+static double time_nms(BoxSuppressor& nms, const BoxSet& input, int iters, size_t& kept) {
+    BoxSet boxes;
+    double total = 0.0;
+    for (int i = 0; i < iters; ++i) {
+        boxes = input;
+        auto t1 = std::chrono::steady_clock::now();
+        nms.run(boxes);
+        auto t2 = std::chrono::steady_clock::now();
+        total += std::chrono::duration<double, std::micro>(t2 - t1).count();
+    }
+    kept = boxes.size();
+    return total / iters;
+}
+
+int main() {
+    const int counts[] = { 300, 1000, 3000, 10000 };
+    const struct { NmsMethod method; const char* name; } methods[] = {
+        { NmsMethod::HARD, "hard" },
+        { NmsMethod::SOFT_LINEAR, "soft-linear" },
+        { NmsMethod::SOFT_GAUSSIAN, "soft-gaussian" },
+        { NmsMethod::WEIGHTED, "weighted" },
+    };
+    std::printf("%-14s %-10s %8s %14s %14s %8s\n", "method", "classes", "boxes", "linear (us)",
+        "bucketed (us)", "kept");
+    for (auto m : methods) {
+        for (int aware = 1; aware >= 0; --aware)
+        for (int count : counts) {
+            BoxSet input = make_candidates(count, 2023);
+            int iters = count <= 1000 ? 200 : 20;
+            NmsConfig config;
+            config.method = m.method;
+            config.score_threshold = 0.05f;
+            config.class_aware = aware == 1;
+            config.bucket_min_boxes = count + 1;
+            BoxSuppressor linear(config);
+            config.bucket_min_boxes = 0;
+            BoxSuppressor bucketed(config);
+            size_t kept_linear = 0, kept_bucketed = 0;
+            double t_linear = time_nms(linear, input, iters, kept_linear);
+            double t_bucketed = time_nms(bucketed, input, iters, kept_bucketed);
+            std::printf("%-14s %-10s %8d %14.1f %14.1f %8zu%s\n", m.name, aware ? "aware" : "agnostic",
+                count, t_linear, t_bucketed, kept_linear,
+                kept_linear == kept_bucketed ? "" : "  (bucketed result differs)");
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,90 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  19:06:41
+// @Brief  : This is the thread scaling benchmark.
+// @File    : thread_scaling_benchmark.cpp
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : Measures the end-to-end throughput (preprocess and inference of 1080p frames) of the
+//                request pool for a CPU thread budget of 1 to N cores, against the default setup where
+//                OpenCV and OpenVINO both size their pools to the whole machine.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "opencv2/opencv.hpp"
+#include "rtdert_predictor.h"
+#include "thread_budget.h"
+
+
+/**
+ * The function returns the frames per second of `rounds` batches after one warm-up batch.
+ */
+static double run_fps(RTDETRPredictor& predictor, const std::vector<ImageView>& frames, int rounds) {
+    predictor.detect_batch(frames);
+    auto t1 = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; ++i) {
+        predictor.detect_batch(frames);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    return frames.size() * rounds / std::chrono::duration<double>(t2 - t1).count();
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::printf("Usage: thread_scaling_benchmark [model path] [lable path] [post flag(1/0)] "
+            "[requests(4)] [rounds(10)] [image]\n");
+        return 0;
+    }
+    bool post_flag = argc > 3 ? std::atoi(argv[3]) != 0 : true;
+    int num_requests = argc > 4 ? std::atoi(argv[4]) : 4;
+    int rounds = argc > 5 ? std::atoi(argv[5]) : 10;
+    cv::Mat image = argc > 6 ? cv::imread(argv[6]) : cv::Mat();
+    if (image.empty()) {
+        image = cv::Mat(1080, 1920, CV_8UC3);
+        cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(255));
+    } else {
+        cv::resize(image, image, cv::Size(1920, 1080));
+    }
+    // Two batches worth of frames, so that every request of the pool is busy.
+    std::vector<ImageView> frames(2 * num_requests, ImageView::from_mat(image));
+    int max_cores = (int)available_cores().size();
+
+    std::vector<int> budgets;
+    for (int n = 1; n < max_cores; n *= 2) {
+        budgets.push_back(n);
+    }
+    budgets.push_back(max_cores);
+
+    std::printf("%8s %10s %10s %8s %10s %10s\n", "cores", "preprocess", "inference", "streams", "fps",
+        "fps/core");
+    double fps_one = 0;
+    for (int cores : budgets) {
+        PredictorOptions options;
+        options.num_requests = num_requests;
+        options.cpu_threads = cores;
+        RTDETRPredictor predictor(argv[1], argv[2], "CPU", post_flag, options);
+        ThreadBudget budget = predictor.get_thread_budget();
+        double fps = run_fps(predictor, frames, rounds);
+        fps_one = fps_one > 0 ? fps_one : fps;
+        std::printf("%8d %10d %10d %8d %10.2f %10.2f  (x%.2f)\n", cores, budget.host_threads,
+            budget.infer_threads, budget.streams, fps, fps / cores, fps / fps_one);
+    }
+
+    // The unbudgeted baseline: both pools default to every core. OpenCV keeps the last budget until
+    // it is reset.
+    cv::setNumThreads(-1);
+    PredictorOptions options;
+    options.num_requests = num_requests;
+    RTDETRPredictor predictor(argv[1], argv[2], "CPU", post_flag, options);
+    double fps = run_fps(predictor, frames, rounds);
+    std::printf("%8s %10d %10s %8s %10.2f %10.2f\n", "default", cv::getNumThreads(), "all", "auto", fps,
+        fps / max_cores);
+    return 0;
+}
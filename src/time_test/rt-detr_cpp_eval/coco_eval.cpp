@@ -0,0 +1,257 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  17:34:02
+// @Brief  : This is common class.
+// @File    : coco_eval.cpp
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : 
+
+#include "coco_eval.h"
+#include <algorithm>
+#include <cstdio>
+#include <numeric>
+
+
+/**
+ * The CocoEvaluator constructor indexes the ground truths by image and category. The dataset must
+ * outlive the evaluator.
+ *
+ * @param max_detections The detections kept per image and category, 100 as in COCO.
+ */
+CocoEvaluator::CocoEvaluator(const CocoDataset& dataset, int max_detections)
+    : max_detections(max_detections) {
+    for (int i = 0; i < 10; ++i) {
+        iou_thresholds.push_back(0.5 + i * (0.95 - 0.5) / 9);
+    }
+    for (const CocoImage& image : dataset.images) {
+        image_ids.push_back(image.id);
+    }
+    std::sort(image_ids.begin(), image_ids.end());
+    for (const CocoCategory& category : dataset.categories) {
+        category_ids.push_back(category.id);
+    }
+    std::sort(category_ids.begin(), category_ids.end());
+    for (const CocoAnnotation& gt : dataset.annotations) {
+        gts[std::make_pair(gt.image_id, gt.category_id)].push_back(&gt);
+    }
+}
+
+void CocoEvaluator::add(const CocoDetection& detection) {
+    dts[std::make_pair(detection.image_id, detection.category_id)].push_back(detection);
+}
+
+void CocoEvaluator::add(const std::vector<CocoDetection>& detections) {
+    for (const CocoDetection& detection : detections) {
+        add(detection);
+    }
+}
+
+/**
+ * The function matches the detections of one category in one image to the ground truths, greedily
+ * in score order at every IoU threshold, like COCOeval.evaluateImg. Ground truths that are crowds
+ * or outside the area range are ignored, and so are the detections matched to them and the
+ * unmatched detections outside the area range.
+ */
+void CocoEvaluator::evaluate_image(const std::vector<const CocoAnnotation*>& gts,
+    std::vector<const CocoDetection*> dts, float min_area, float max_area, ImageResult& result) const {
+    // The ignored ground truths go last, so a detection prefers a real match.
+    std::vector<const CocoAnnotation*> sorted_gts(gts);
+    std::vector<char> gt_ignore;
+    std::stable_sort(sorted_gts.begin(), sorted_gts.end(), [&](const CocoAnnotation* a, const CocoAnnotation* b) {
+        bool ia = a->iscrowd || a->area < min_area || a->area > max_area;
+        bool ib = b->iscrowd || b->area < min_area || b->area > max_area;
+        return ia < ib;
+    });
+    result.num_gt = 0;
+    for (const CocoAnnotation* gt : sorted_gts) {
+        gt_ignore.push_back(gt->iscrowd || gt->area < min_area || gt->area > max_area);
+        result.num_gt += gt_ignore.back() ? 0 : 1;
+    }
+    std::stable_sort(dts.begin(), dts.end(), [](const CocoDetection* a, const CocoDetection* b) {
+        return a->score > b->score;
+    });
+    if ((int)dts.size() > max_detections) {
+        dts.resize(max_detections);
+    }
+
+    const size_t G = sorted_gts.size(), D = dts.size();
+    std::vector<double> ious(D * G);
+    for (size_t d = 0; d < D; ++d) {
+        const CocoBox& a = dts[d]->box;
+        for (size_t g = 0; g < G; ++g) {
+            const CocoBox& b = sorted_gts[g]->box;
+            double w = std::min(a.x + a.width, b.x + b.width) - std::max(a.x, b.x);
+            double h = std::min(a.y + a.height, b.y + b.height) - std::max(a.y, b.y);
+            double inter = w > 0 && h > 0 ? w * h : 0.0;
+            // A crowd region is matched by the share of the detection inside it.
+            double area = (double)a.width * a.height;
+            double denom = sorted_gts[g]->iscrowd ? area : area + (double)b.width * b.height - inter;
+            ious[d * G + g] = denom > 0 ? inter / denom : 0.0;
+        }
+    }
+
+    result.scores.resize(D);
+    for (size_t d = 0; d < D; ++d) {
+        result.scores[d] = dts[d]->score;
+    }
+    result.matched.assign(iou_thresholds.size(), std::vector<char>(D, 0));
+    result.ignored.assign(iou_thresholds.size(), std::vector<char>(D, 0));
+    std::vector<char> gt_matched(G);
+    for (size_t t = 0; t < iou_thresholds.size(); ++t) {
+        std::fill(gt_matched.begin(), gt_matched.end(), 0);
+        for (size_t d = 0; d < D; ++d) {
+            double best = std::min(iou_thresholds[t], 1 - 1e-10);
+            int m = -1;
+            for (size_t g = 0; g < G; ++g) {
+                if (gt_matched[g] && !sorted_gts[g]->iscrowd) {
+                    continue;
+                }
+                if (m > -1 && !gt_ignore[m] && gt_ignore[g]) {
+                    break;
+                }
+                if (ious[d * G + g] < best) {
+                    continue;
+                }
+                best = ious[d * G + g];
+                m = (int)g;
+            }
+            if (m == -1) {
+                float area = dts[d]->box.width * dts[d]->box.height;
+                result.ignored[t][d] = area < min_area || area > max_area;
+            } else {
+                result.matched[t][d] = 1;
+                result.ignored[t][d] = gt_ignore[m];
+                gt_matched[m] = 1;
+            }
+        }
+    }
+}
+
+/**
+ * The function `evaluate` computes the COCO box metrics: per area range, category and IoU threshold
+ * the detections of all images are ranked by score, the precision envelope is sampled at 101 recall
+ * points and averaged; the categories without ground truth are skipped.
+ */
+CocoMetrics CocoEvaluator::evaluate() const {
+    const float areas[4][2] = { { 0.0f, 1e10f }, { 0.0f, 32.0f * 32.0f }, { 32.0f * 32.0f, 96.0f * 96.0f },
+        { 96.0f * 96.0f, 1e10f } };
+    const size_t T = iou_thresholds.size();
+    const int R = 101;
+    std::vector<const CocoAnnotation*> no_gts;
+    // The sums and counts of AP over (threshold, category), and of the recall for the whole range.
+    double ap_sum[4][10] = {}, recall_sum = 0.0;
+    int ap_count[4] = {}, recall_count = 0;
+
+    for (int a = 0; a < 4; ++a) {
+        for (int category : category_ids) {
+            std::vector<float> scores;
+            std::vector<std::vector<char>> matched(T), ignored(T);
+            int num_gt = 0;
+            ImageResult result;
+            for (int image : image_ids) {
+                auto key = std::make_pair(image, category);
+                auto g = gts.find(key);
+                auto d = dts.find(key);
+                if (g == gts.end() && d == dts.end()) {
+                    continue;
+                }
+                std::vector<const CocoDetection*> image_dts;
+                if (d != dts.end()) {
+                    for (const CocoDetection& det : d->second) {
+                        image_dts.push_back(&det);
+                    }
+                }
+                evaluate_image(g == gts.end() ? no_gts : g->second, image_dts, areas[a][0], areas[a][1], result);
+                num_gt += result.num_gt;
+                scores.insert(scores.end(), result.scores.begin(), result.scores.end());
+                for (size_t t = 0; t < T; ++t) {
+                    matched[t].insert(matched[t].end(), result.matched[t].begin(), result.matched[t].end());
+                    ignored[t].insert(ignored[t].end(), result.ignored[t].begin(), result.ignored[t].end());
+                }
+            }
+            if (num_gt == 0) {
+                continue;
+            }
+            std::vector<size_t> order(scores.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::stable_sort(order.begin(), order.end(), [&](size_t i, size_t j) { return scores[i] > scores[j]; });
+            for (size_t t = 0; t < T; ++t) {
+                std::vector<double> precision, recall;
+                double tp = 0, fp = 0;
+                for (size_t i : order) {
+                    if (ignored[t][i]) {
+                        continue;
+                    }
+                    (matched[t][i] ? tp : fp) += 1;
+                    recall.push_back(tp / num_gt);
+                    precision.push_back(tp / (tp + fp));
+                }
+                for (size_t i = precision.size(); i > 1; --i) {
+                    precision[i - 2] = std::max(precision[i - 2], precision[i - 1]);
+                }
+                double ap = 0.0;
+                for (int r = 0; r < R; ++r) {
+                    double threshold = r / 100.0;
+                    size_t i = std::lower_bound(recall.begin(), recall.end(), threshold) - recall.begin();
+                    if (i >= precision.size()) {
+                        break;
+                    }
+                    ap += precision[i];
+                }
+                ap_sum[a][t] += ap / R;
+                if (a == 0) {
+                    recall_sum += recall.empty() ? 0.0 : recall.back();
+                    ++recall_count;
+                }
+            }
+            ++ap_count[a];
+        }
+    }
+
+    CocoMetrics metrics;
+    auto mean = [&](int a, size_t t0, size_t t1) {
+        double sum = 0.0;
+        for (size_t t = t0; t < t1; ++t) {
+            sum += ap_sum[a][t];
+        }
+        return ap_count[a] > 0 ? sum / (ap_count[a] * (t1 - t0)) : -1.0;
+    };
+    metrics.ap = mean(0, 0, T);
+    metrics.ap50 = mean(0, 0, 1);
+    metrics.ap75 = mean(0, 5, 6);
+    metrics.ap_small = mean(1, 0, T);
+    metrics.ap_medium = mean(2, 0, T);
+    metrics.ap_large = mean(3, 0, T);
+    metrics.ar100 = recall_count > 0 ? recall_sum / recall_count : -1.0;
+    return metrics;
+}
+
+/**
+ * The function `check_baseline` compares the metrics with those of a baseline report, e.g. the last
+ * accepted run of the same model. A metric more than `tolerance` below the baseline is a regression;
+ * the metrics the baseline does not have (-1) are skipped.
+ *
+ * @param regressions Receives one line per regressed metric.
+ * @return true if no metric regressed.
+ */
+bool check_baseline(const CocoMetrics& metrics, const CocoMetrics& baseline, double tolerance,
+    std::vector<std::string>& regressions) {
+    const struct { const char* name; double value, base; } checks[] = {
+        { "AP@[.50:.95]", metrics.ap, baseline.ap }, { "AP50", metrics.ap50, baseline.ap50 },
+        { "AP75", metrics.ap75, baseline.ap75 }, { "APs", metrics.ap_small, baseline.ap_small },
+        { "APm", metrics.ap_medium, baseline.ap_medium }, { "APl", metrics.ap_large, baseline.ap_large },
+        { "AR100", metrics.ar100, baseline.ar100 } };
+    regressions.clear();
+    for (const auto& check : checks) {
+        if (check.base >= 0.0 && check.value < check.base - tolerance) {
+            char line[128];
+            std::snprintf(line, sizeof(line), "%s %.4f is below the baseline %.4f (tolerance %.4f)",
+                check.name, check.value, check.base, tolerance);
+            regressions.push_back(line);
+        }
+    }
+    return regressions.empty();
+}
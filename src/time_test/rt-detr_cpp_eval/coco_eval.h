@@ -0,0 +1,99 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  17:20:36
+// @Brief  : This is common class.
+// @File    : coco_eval.h
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : COCO-style box mAP, following the pycocotools COCOeval protocol. It does not depend
+//                on OpenCV or OpenVINO.
+#ifndef __COCO_EVAL_H__
+#define __COCO_EVAL_H__
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+// A box in COCO order: the top left corner and the size.
+struct CocoBox {
+    float x, y, width, height;
+};
+
+struct CocoImage {
+    int id;
+    std::string file_name;
+    int width, height;
+};
+
+struct CocoAnnotation {
+    int image_id;
+    int category_id;
+    CocoBox box;
+    float area;                 // The segment area COCO sizes objects by, the box area if missing.
+    bool iscrowd;               // Crowd regions are ignored, detections on them are not counted.
+};
+
+struct CocoCategory {
+    int id;
+    std::string name;
+};
+
+struct CocoDataset {
+    std::vector<CocoImage> images;
+    std::vector<CocoCategory> categories;       // Sorted by id.
+    std::vector<CocoAnnotation> annotations;
+};
+
+struct CocoDetection {
+    int image_id;
+    int category_id;
+    CocoBox box;
+    float score;
+};
+
+struct CocoMetrics {
+    double ap;                  // AP@[.50:.05:.95], the COCO mAP.
+    double ap50;
+    double ap75;
+    double ap_small;            // Area < 32^2.
+    double ap_medium;
+    double ap_large;            // Area > 96^2.
+    double ar100;               // The recall with up to 100 detections per image.
+};
+
+bool check_baseline(const CocoMetrics& metrics, const CocoMetrics& baseline, double tolerance,
+    std::vector<std::string>& regressions);
+
+class CocoEvaluator
+{
+public:
+    explicit CocoEvaluator(const CocoDataset& dataset, int max_detections = 100);
+    void add(const CocoDetection& detection);
+    void add(const std::vector<CocoDetection>& detections);
+    CocoMetrics evaluate() const;
+
+private:
+    // The detections of one category in one image, evaluated at every IoU threshold.
+    struct ImageResult {
+        std::vector<float> scores;
+        std::vector<std::vector<char>> matched;     // [threshold][detection]
+        std::vector<std::vector<char>> ignored;
+        int num_gt;                                 // The ground truths that are not ignored.
+    };
+
+    void evaluate_image(const std::vector<const CocoAnnotation*>& gts, std::vector<const CocoDetection*> dts,
+        float min_area, float max_area, ImageResult& result) const;
+
+private:
+    std::vector<double> iou_thresholds;
+    int max_detections;
+    std::vector<int> image_ids;
+    std::vector<int> category_ids;
+    std::map<std::pair<int, int>, std::vector<const CocoAnnotation*>> gts;     // (image, category)
+    std::map<std::pair<int, int>, std::vector<CocoDetection>> dts;
+};
+
+#endif // !__COCO_EVAL_H__
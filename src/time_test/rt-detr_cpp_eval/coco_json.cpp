@@ -0,0 +1,110 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  18:06:12
+// @Brief  : This is common class.
+// @File    : coco_json.cpp
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : 
+
+#include "coco_json.h"
+#include <algorithm>
+#include <stdexcept>
+
+#include <opencv2/opencv.hpp>
+
+
+static cv::FileStorage open_json(const std::string& path) {
+    cv::FileStorage fs(path, cv::FileStorage::READ | cv::FileStorage::FORMAT_JSON);
+    if (!fs.isOpened()) {
+        throw std::runtime_error("Cannot open the JSON file '" + path + "'.");
+    }
+    return fs;
+}
+
+static CocoBox read_box(const cv::FileNode& bbox) {
+    return { (float)bbox[0], (float)bbox[1], (float)bbox[2], (float)bbox[3] };
+}
+
+/**
+ * The function `load_coco` reads a COCO instances file: the images, categories and annotations.
+ */
+CocoDataset load_coco(const std::string& path) {
+    cv::FileStorage fs = open_json(path);
+    CocoDataset dataset;
+    cv::FileNode images = fs["images"];
+    for (cv::FileNodeIterator it = images.begin(); it != images.end(); ++it) {
+        cv::FileNode node = *it;
+        CocoImage image;
+        image.id = (int)node["id"];
+        image.file_name = (std::string)node["file_name"];
+        image.width = (int)node["width"];
+        image.height = (int)node["height"];
+        dataset.images.push_back(image);
+    }
+    cv::FileNode categories = fs["categories"];
+    for (cv::FileNodeIterator it = categories.begin(); it != categories.end(); ++it) {
+        cv::FileNode node = *it;
+        dataset.categories.push_back({ (int)node["id"], (std::string)node["name"] });
+    }
+    std::sort(dataset.categories.begin(), dataset.categories.end(),
+        [](const CocoCategory& a, const CocoCategory& b) { return a.id < b.id; });
+    cv::FileNode annotations = fs["annotations"];
+    for (cv::FileNodeIterator it = annotations.begin(); it != annotations.end(); ++it) {
+        cv::FileNode node = *it;
+        CocoAnnotation gt;
+        gt.image_id = (int)node["image_id"];
+        gt.category_id = (int)node["category_id"];
+        gt.box = read_box(node["bbox"]);
+        gt.area = node["area"].empty() ? gt.box.width * gt.box.height : (float)node["area"];
+        gt.iscrowd = !node["iscrowd"].empty() && (int)node["iscrowd"] != 0;
+        dataset.annotations.push_back(gt);
+    }
+    return dataset;
+}
+
+/**
+ * The function `load_detections` reads a COCO results file, the array written by `--detections` or
+ * given to pycocotools' `loadRes`.
+ */
+std::vector<CocoDetection> load_detections(const std::string& path) {
+    cv::FileStorage fs = open_json(path);
+    std::vector<CocoDetection> detections;
+    cv::FileNode root = fs.root();
+    for (cv::FileNodeIterator it = root.begin(); it != root.end(); ++it) {
+        cv::FileNode node = *it;
+        CocoDetection d;
+        d.image_id = (int)node["image_id"];
+        d.category_id = (int)node["category_id"];
+        d.box = read_box(node["bbox"]);
+        d.score = (float)node["score"];
+        detections.push_back(d);
+    }
+    return detections;
+}
+
+/**
+ * The function `load_report_metrics` reads the metrics of a `--report` file. A metric missing from
+ * the report is -1, like a metric without ground truth.
+ */
+CocoMetrics load_report_metrics(const std::string& path) {
+    cv::FileStorage fs = open_json(path);
+    cv::FileNode node = fs["metrics"];
+    if (node.empty()) {
+        throw std::runtime_error("The report '" + path + "' has no metrics.");
+    }
+    auto read = [&node](const char* name) {
+        return node[name].empty() ? -1.0 : (double)node[name];
+    };
+    CocoMetrics metrics;
+    metrics.ap = read("ap");
+    metrics.ap50 = read("ap50");
+    metrics.ap75 = read("ap75");
+    metrics.ap_small = read("ap_small");
+    metrics.ap_medium = read("ap_medium");
+    metrics.ap_large = read("ap_large");
+    metrics.ar100 = read("ar100");
+    return metrics;
+}
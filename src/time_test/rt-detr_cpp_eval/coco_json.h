@@ -0,0 +1,26 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  18:06:12
+// @Brief  : This is common class.
+// @File    : coco_json.h
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : Reading of the COCO JSON files with cv::FileStorage: the instances file, a results
+//                file and the metrics of an evaluation report.
+#ifndef __COCO_JSON_H__
+#define __COCO_JSON_H__
+
+#include <string>
+#include <vector>
+
+#include "coco_eval.h"
+
+CocoDataset load_coco(const std::string& path);
+
+std::vector<CocoDetection> load_detections(const std::string& path);
+
+CocoMetrics load_report_metrics(const std::string& path);
+
+#endif // !__COCO_JSON_H__
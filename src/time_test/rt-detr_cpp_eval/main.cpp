@@ -0,0 +1,300 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  17:58:44
+// @Brief  : This is the evaluation harness.
+// @File    : main.cpp
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : Runs the C++ predictor over a COCO-format annotation set and reports the box mAP
+//                together with the per-image latency, so that a speedup can be judged against its
+//                accuracy cost in one report.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+#include "coco_eval.h"
+#include "coco_json.h"
+#include "image_decoder.h"
+#include "rtdert_predictor.h"
+
+
+struct EvalOptions {
+    std::string model_path, label_path, annotation_path, image_dir;
+    std::string device;
+    bool post_flag;
+    float threshold;            // The score threshold, low so that the whole precision/recall curve counts.
+    int max_images;             // 0 to evaluate every image.
+    bool scaled_decode;         // Decode with `decode_image` instead of cv::imdecode.
+    std::string report_path;
+    std::string detections_path;
+    std::string tag;            // A name for the configuration under test, copied to the report.
+    std::string baseline_path;  // A previous report, the run fails if a metric drops below it.
+    double tolerance;           // The drop from the baseline that is still accepted.
+};
+
+struct LatencyStats {
+    double mean, p50, p90, p99, max;
+};
+
+static LatencyStats latency_stats(std::vector<double> values) {
+    LatencyStats stats = { 0.0, 0.0, 0.0, 0.0, 0.0 };
+    if (values.empty()) {
+        return stats;
+    }
+    std::sort(values.begin(), values.end());
+    auto percentile = [&](double p) {
+        return values[std::min(values.size() - 1, (size_t)(p / 100.0 * values.size()))];
+    };
+    for (double v : values) {
+        stats.mean += v / values.size();
+    }
+    stats.p50 = percentile(50);
+    stats.p90 = percentile(90);
+    stats.p99 = percentile(99);
+    stats.max = values.back();
+    return stats;
+}
+
+static std::string stats_json(const LatencyStats& s) {
+    std::ostringstream out;
+    out << "{\"mean\":" << s.mean << ",\"p50\":" << s.p50 << ",\"p90\":" << s.p90
+        << ",\"p99\":" << s.p99 << ",\"max\":" << s.max << "}";
+    return out.str();
+}
+
+static std::string json_string(const std::string& s) {
+    std::string out = "\"";
+    for (char c : s) {
+        out += c == '"' || c == '\\' ? std::string("\\") + c : std::string(1, c);
+    }
+    return out + "\"";
+}
+
+/**
+ * The function writes the detections in the COCO results format, for cross-checking with pycocotools.
+ */
+static void write_detections(const std::string& path, const std::vector<CocoDetection>& detections) {
+    std::ofstream out(path);
+    out << "[";
+    for (size_t i = 0; i < detections.size(); ++i) {
+        const CocoDetection& d = detections[i];
+        out << (i ? ",\n" : "\n") << "{\"image_id\":" << d.image_id << ",\"category_id\":" << d.category_id
+            << ",\"bbox\":[" << d.box.x << "," << d.box.y << "," << d.box.width << "," << d.box.height
+            << "],\"score\":" << d.score << "}";
+    }
+    out << "\n]\n";
+}
+
+/**
+ * The function evaluates the model and writes the report.
+ *
+ * @return the exit code, non-zero if a metric regressed against the baseline.
+ */
+static int evaluate(const EvalOptions& options) {
+    CocoDataset dataset = load_coco(options.annotation_path);
+    INFO("Images: " << dataset.images.size() << ", categories: " << dataset.categories.size()
+        << ", annotations: " << dataset.annotations.size());
+    // The model classes are mapped to the categories by label name, or by rank of the category id
+    // (the usual 80-class COCO order) if the name is not a category.
+    std::map<std::string, int> category_by_name;
+    for (const CocoCategory& category : dataset.categories) {
+        category_by_name[category.name] = category.id;
+    }
+
+    RTDETRPredictor predictor(options.model_path, options.label_path, options.device, options.post_flag);
+    FilterConfig filter;
+    filter.threshold = options.threshold;
+    filter.max_detections = 100;
+    predictor.set_filter(filter);
+
+    std::vector<CocoDetection> all_detections;
+    std::vector<double> decode_ms, detect_ms, total_ms;
+    double first_ms = 0.0;
+    // The images that are missing or cannot be decoded are reported and left out of the score, so that
+    // their ground truths are not counted as misses of the model.
+    std::vector<std::string> failed_images;
+    std::vector<int> failed_ids;
+    size_t count = dataset.images.size();
+    if (options.max_images > 0) {
+        count = std::min(count, (size_t)options.max_images);
+    }
+    for (size_t i = 0; i < count; ++i) {
+        const CocoImage& image = dataset.images[i];
+        std::ifstream file(options.image_dir + "/" + image.file_name, std::ios::binary);
+        std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        auto t1 = std::chrono::steady_clock::now();
+        DecodedImage decoded;
+        if (!data.empty()) {
+            try {
+                if (options.scaled_decode) {
+                    decode_image(data.data(), data.size(), predictor.get_input_size(), decoded);
+                } else {
+                    decoded.pixels = cv::imdecode(data, cv::IMREAD_COLOR);
+                }
+            }
+            catch (const std::exception&) {
+                decoded = DecodedImage();
+            }
+        }
+        if (decoded.empty()) {
+            INFO("Excluding the " << (data.empty() ? "missing" : "undecodable") << " image " << image.file_name);
+            failed_images.push_back(image.file_name);
+            failed_ids.push_back(image.id);
+            continue;
+        }
+        auto t2 = std::chrono::steady_clock::now();
+        ResultData result = predictor.detect(decoded.view());
+        auto t3 = std::chrono::steady_clock::now();
+
+        double decode = std::chrono::duration<double, std::milli>(t2 - t1).count();
+        double detect = std::chrono::duration<double, std::milli>(t3 - t2).count();
+        // The first scored image pays the lazy allocations and is reported on its own.
+        if (i == failed_images.size()) {
+            first_ms = decode + detect;
+        } else {
+            decode_ms.push_back(decode);
+            detect_ms.push_back(detect);
+            total_ms.push_back(decode + detect);
+        }
+        for (size_t k = 0; k < result.clsids.size(); ++k) {
+            CocoDetection d;
+            d.image_id = image.id;
+            auto named = category_by_name.find(result.labels[k]);
+            if (named != category_by_name.end()) {
+                d.category_id = named->second;
+            } else if (result.clsids[k] >= 0 && result.clsids[k] < (int)dataset.categories.size()) {
+                d.category_id = dataset.categories[result.clsids[k]].id;
+            } else {
+                continue;
+            }
+            const cv::Rect& b = result.bboxs[k];
+            d.box = { (float)b.x, (float)b.y, (float)b.width, (float)b.height };
+            d.score = result.scores[k];
+            all_detections.push_back(d);
+        }
+        if ((i + 1) % 100 == 0) {
+            INFO("  " << i + 1 << " / " << count);
+        }
+    }
+    // Only the evaluated images count, a partial run is not scored against unseen images.
+    dataset.images.resize(count);
+    dataset.images.erase(std::remove_if(dataset.images.begin(), dataset.images.end(), [&](const CocoImage& image) {
+        return std::find(failed_ids.begin(), failed_ids.end(), image.id) != failed_ids.end();
+    }), dataset.images.end());
+    if (!failed_images.empty()) {
+        INFO(failed_images.size() << " of " << count << " images were missing or undecodable and are not scored.");
+    }
+    CocoEvaluator evaluator(dataset);
+    evaluator.add(all_detections);
+    CocoMetrics m = evaluator.evaluate();
+
+    LatencyStats decode = latency_stats(decode_ms), detect = latency_stats(detect_ms), total = latency_stats(total_ms);
+    double fps = total.mean > 0 ? 1000.0 / total.mean : 0.0;
+    INFO("Accuracy" << (options.tag.empty() ? "" : " [" + options.tag + "]"));
+    std::printf("  AP@[.50:.95] %.4f  AP50 %.4f  AP75 %.4f  APs %.4f  APm %.4f  APl %.4f  AR100 %.4f\n",
+        m.ap, m.ap50, m.ap75, m.ap_small, m.ap_medium, m.ap_large, m.ar100);
+    INFO("Latency (ms), first image " << first_ms);
+    std::printf("  %-8s %8s %8s %8s %8s %8s\n", "", "mean", "p50", "p90", "p99", "max");
+    std::printf("  %-8s %8.2f %8.2f %8.2f %8.2f %8.2f\n", "decode", decode.mean, decode.p50, decode.p90, decode.p99, decode.max);
+    std::printf("  %-8s %8.2f %8.2f %8.2f %8.2f %8.2f\n", "detect", detect.mean, detect.p50, detect.p90, detect.p99, detect.max);
+    std::printf("  %-8s %8.2f %8.2f %8.2f %8.2f %8.2f   (%.1f FPS)\n", "total", total.mean, total.p50, total.p90,
+        total.p99, total.max, fps);
+
+    if (!options.report_path.empty()) {
+        std::ofstream out(options.report_path);
+        out << "{\"tag\":" << json_string(options.tag)
+            << ",\"model\":" << json_string(options.model_path)
+            << ",\"device\":" << json_string(options.device)
+            << ",\"images\":" << dataset.images.size()
+            << ",\"failed_images\":[";
+        for (size_t k = 0; k < failed_images.size(); ++k) {
+            out << (k ? "," : "") << json_string(failed_images[k]);
+        }
+        out << "]"
+            << ",\"threshold\":" << options.threshold
+            << ",\"scaled_decode\":" << (options.scaled_decode ? "true" : "false")
+            << ",\"metrics\":{\"ap\":" << m.ap << ",\"ap50\":" << m.ap50 << ",\"ap75\":" << m.ap75
+            << ",\"ap_small\":" << m.ap_small << ",\"ap_medium\":" << m.ap_medium << ",\"ap_large\":" << m.ap_large
+            << ",\"ar100\":" << m.ar100 << "}"
+            << ",\"latency_ms\":{\"first\":" << first_ms << ",\"decode\":" << stats_json(decode)
+            << ",\"detect\":" << stats_json(detect) << ",\"total\":" << stats_json(total) << "}"
+            << ",\"fps\":" << fps << "}\n";
+        INFO("Report written to " + options.report_path);
+    }
+    if (!options.detections_path.empty()) {
+        write_detections(options.detections_path, all_detections);
+    }
+    if (!options.baseline_path.empty()) {
+        std::vector<std::string> regressions;
+        if (!check_baseline(m, load_report_metrics(options.baseline_path), options.tolerance, regressions)) {
+            INFO("Accuracy regressed against " + options.baseline_path);
+            for (const std::string& regression : regressions) {
+                INFO("  " + regression);
+            }
+            return 1;
+        }
+        INFO("No metric is below the baseline " + options.baseline_path);
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 7) {
+        INFO("Please enter the correct parameters.");
+        INFO("For example:");
+        INFO("  rt-detr_cpp_eval [model path] [lable path] [annotation json] [image dir] [device] [post flag(1/0)]");
+        INFO("      [--threshold 0.01] [--max-images N] [--scaled-decode] [--report report.json]");
+        INFO("      [--detections detections.json] [--tag name] [--baseline report.json] [--tolerance 0.005]");
+        return 0;
+    }
+    EvalOptions options;
+    options.model_path = argv[1];
+    options.label_path = argv[2];
+    options.annotation_path = argv[3];
+    options.image_dir = argv[4];
+    options.device = argv[5];
+    std::istringstream(argv[6]) >> options.post_flag;
+    options.threshold = 0.01f;
+    options.max_images = 0;
+    options.scaled_decode = false;
+    options.tolerance = 0.005;
+    for (int i = 7; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--scaled-decode") {
+            options.scaled_decode = true;
+        } else if (arg == "--threshold" && has_value) {
+            options.threshold = (float)std::atof(argv[++i]);
+        } else if (arg == "--max-images" && has_value) {
+            options.max_images = std::atoi(argv[++i]);
+        } else if (arg == "--report" && has_value) {
+            options.report_path = argv[++i];
+        } else if (arg == "--detections" && has_value) {
+            options.detections_path = argv[++i];
+        } else if (arg == "--tag" && has_value) {
+            options.tag = argv[++i];
+        } else if (arg == "--baseline" && has_value) {
+            options.baseline_path = argv[++i];
+        } else if (arg == "--tolerance" && has_value) {
+            options.tolerance = std::atof(argv[++i]);
+        } else {
+            INFO("Unknown option " + arg);
+            return 1;
+        }
+    }
+    return evaluate(options);
+}
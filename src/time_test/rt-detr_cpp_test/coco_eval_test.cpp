@@ -0,0 +1,113 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  18:12:47
+// @Brief  : This is the COCO mAP test.
+// @File    : coco_eval_test.cpp
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : Checks `CocoEvaluator` against hand-computed cases, and against the pycocotools
+//                metrics of a small annotation and results set (data/coco_gt.json, coco_dt.json and
+//                the report coco_baseline.json). It also checks that `check_baseline` fails a lower
+//                mAP.
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "coco_eval.h"
+#include "coco_json.h"
+#include "test_check.h"
+
+
+static CocoDataset one_image(const std::vector<CocoAnnotation>& annotations) {
+    CocoDataset dataset;
+    dataset.images.push_back({ 1, "1.jpg", 640, 480 });
+    dataset.categories.push_back({ 1, "person" });
+    dataset.annotations = annotations;
+    return dataset;
+}
+
+static CocoAnnotation gt(float x, float y, float width, float height, bool iscrowd = false) {
+    return { 1, 1, { x, y, width, height }, width * height, iscrowd };
+}
+
+static CocoDetection dt(float x, float y, float width, float height, float score) {
+    return { 1, 1, { x, y, width, height }, score };
+}
+
+static bool near(double a, double b, double tolerance = 1e-6) {
+    return std::fabs(a - b) <= tolerance;
+}
+
+/**
+ * The function checks the cases whose metrics follow from the protocol by hand.
+ */
+static void test_hand_computed() {
+    // Perfect detections.
+    CocoDataset perfect = one_image({ gt(100, 100, 200, 200), gt(400, 50, 100, 300) });
+    CocoEvaluator e1(perfect);
+    e1.add(dt(100, 100, 200, 200, 0.9f));
+    e1.add(dt(400, 50, 100, 300, 0.8f));
+    CocoMetrics m1 = e1.evaluate();
+    CHECK(near(m1.ap, 1.0) && near(m1.ap50, 1.0) && near(m1.ar100, 1.0));
+
+    // Half the ground truths found: the precision is 1 up to recall 0.5, 51 of the 101 recall points.
+    CocoDataset half = one_image({ gt(100, 100, 200, 200), gt(400, 50, 100, 300) });
+    CocoEvaluator e2(half);
+    e2.add(dt(100, 100, 200, 200, 0.9f));
+    CocoMetrics m2 = e2.evaluate();
+    CHECK(near(m2.ap, 51.0 / 101.0));
+    CHECK(near(m2.ar100, 0.5));
+
+    // A detection on a crowd region is ignored, not a false positive, even with the top score.
+    CocoDataset crowd = one_image({ gt(100, 100, 200, 200), gt(350, 50, 250, 400, true) });
+    CocoEvaluator e3(crowd);
+    e3.add(dt(400, 100, 100, 100, 0.95f));
+    e3.add(dt(100, 100, 200, 200, 0.5f));
+    CHECK(near(e3.evaluate().ap, 1.0));
+
+    // IoU 0.82 matches at the thresholds .50 to .80, 7 of the 10.
+    CocoDataset partial = one_image({ gt(0, 0, 100, 100) });
+    CocoEvaluator e4(partial);
+    e4.add(dt(0, 0, 100, 82, 0.9f));
+    CocoMetrics m4 = e4.evaluate();
+    CHECK(near(m4.ap, 0.7));
+    CHECK(near(m4.ap50, 1.0) && near(m4.ap75, 1.0));
+}
+
+/**
+ * The function checks the metrics of the fixture against the pycocotools report, and that a lower
+ * result is flagged by `check_baseline`.
+ */
+static void test_against_pycocotools(const std::string& data_dir) {
+    CocoDataset dataset = load_coco(data_dir + "/coco_gt.json");
+    CHECK(dataset.images.size() == 3 && dataset.annotations.size() == 10);
+    CocoEvaluator evaluator(dataset);
+    evaluator.add(load_detections(data_dir + "/coco_dt.json"));
+    CocoMetrics m = evaluator.evaluate();
+    CocoMetrics expected = load_report_metrics(data_dir + "/coco_baseline.json");
+    CHECK(near(m.ap, expected.ap));
+    CHECK(near(m.ap50, expected.ap50));
+    CHECK(near(m.ap75, expected.ap75));
+    CHECK(near(m.ap_small, expected.ap_small));
+    CHECK(near(m.ap_medium, expected.ap_medium));
+    CHECK(near(m.ap_large, expected.ap_large));
+    CHECK(near(m.ar100, expected.ar100));
+
+    std::vector<std::string> regressions;
+    CHECK(check_baseline(m, expected, 0.005, regressions));
+    CocoMetrics lower = m;
+    lower.ap -= 0.01;
+    CHECK(!check_baseline(lower, expected, 0.005, regressions));
+    CHECK(regressions.size() == 1);
+    CHECK(check_baseline(lower, expected, 0.02, regressions));
+}
+
+int main(int argc, char* argv[]) {
+    const std::string data_dir = argc > 1 ? argv[1] : "data";
+    test_hand_computed();
+    test_against_pycocotools(data_dir);
+    return test_result("coco_eval_test");
+}
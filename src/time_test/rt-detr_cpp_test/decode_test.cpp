@@ -0,0 +1,88 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  10:11:05
+// @Brief  : This is the decode test.
+// @File    : decode_test.cpp
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : Checks that `decode_image` ignores the EXIF orientation of a JPEG: a phone photo
+//                tagged "rotate 90°" must come out in the size of its JPEG header, with the pixels
+//                unrotated, whether it is decoded at full size or DCT-scaled.
+
+#include <cstdint>
+#include <vector>
+
+#include "opencv2/opencv.hpp"
+#include "image_decoder.h"
+#include "test_check.h"
+
+
+/**
+ * The function encodes a landscape JPEG and inserts an EXIF APP1 segment with the given orientation
+ * right after the SOI marker. The left half of the image is white, the right half black.
+ */
+static std::vector<uint8_t> make_exif_jpeg(int width, int height, uint16_t orientation) {
+    cv::Mat image(height, width, CV_8UC3, cv::Scalar(0, 0, 0));
+    image(cv::Rect(0, 0, width / 2, height)).setTo(cv::Scalar(255, 255, 255));
+    std::vector<uint8_t> jpeg;
+    cv::imencode(".jpg", image, jpeg, { cv::IMWRITE_JPEG_QUALITY, 95 });
+    // APP1: "Exif\0\0", a little-endian TIFF header and one IFD holding the orientation tag (0x0112).
+    const uint8_t app1[] = {
+        0xFF, 0xE1, 0x00, 0x22,
+        'E', 'x', 'i', 'f', 0x00, 0x00,
+        'I', 'I', 0x2A, 0x00, 0x08, 0x00, 0x00, 0x00,
+        0x01, 0x00,
+        0x12, 0x01, 0x03, 0x00, 0x01, 0x00, 0x00, 0x00,
+        (uint8_t)(orientation & 0xFF), (uint8_t)(orientation >> 8), 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00 };
+    jpeg.insert(jpeg.begin() + 2, app1, app1 + sizeof(app1));
+    return jpeg;
+}
+
+/**
+ * The function checks the decoded size against the JPEG header and that the white half is still on
+ * the left, i.e. the pixels were not rotated.
+ */
+static void check_unrotated(const DecodedImage& image, int width, int height) {
+    CHECK(!image.empty());
+    if (image.empty()) {
+        return;
+    }
+    CHECK(image.full_width == width);
+    CHECK(image.full_height == height);
+    CHECK(image.pixels.cols * image.scale_denom == width);
+    CHECK(image.pixels.rows * image.scale_denom == height);
+    cv::Mat gray;
+    if (image.pixels.channels() == 1) {
+        gray = image.pixels;
+    } else {
+        cv::cvtColor(image.pixels, gray, cv::COLOR_BGR2GRAY);
+    }
+    int row = gray.rows / 2;
+    CHECK(gray.at<uint8_t>(row, gray.cols / 8) > 200);
+    CHECK(gray.at<uint8_t>(row, gray.cols * 7 / 8) < 50);
+}
+
+int main() {
+    const int width = 640, height = 320;
+    std::vector<uint8_t> jpeg = make_exif_jpeg(width, height, 6);
+
+    int header_width = 0, header_height = 0;
+    CHECK(read_jpeg_size(jpeg.data(), jpeg.size(), header_width, header_height));
+    CHECK(header_width == width && header_height == height);
+
+    DecodedImage full;
+    decode_image(jpeg.data(), jpeg.size(), cv::Size(640, 640), full, false);
+    CHECK(full.scale_denom == 1);
+    check_unrotated(full, width, height);
+
+    // A small target size decodes the JPEG DCT-scaled.
+    DecodedImage scaled;
+    decode_image(jpeg.data(), jpeg.size(), cv::Size(160, 160), scaled, true);
+    CHECK(scaled.scale_denom > 1);
+    check_unrotated(scaled, width, height);
+
+    return test_result("decode_test");
+}
@@ -0,0 +1,93 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  20:58:16
+// @Brief  : This is the model info test.
+// @File    : model_info_test.cpp
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : Checks the role resolution of a raw head model with an extra rank 3 output (e.g.
+//                exported query features): the shapes alone are ambiguous, the names of a model
+//                bundle resolve it, and the roles the bundle leaves out are still inferred.
+
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "openvino/openvino.hpp"
+#include "openvino/opsets/opset8.hpp"
+#include "model_bundle.h"
+#include "model_info.h"
+#include "test_check.h"
+
+
+/**
+ * The function builds a raw head model: a [1,3,640,640] image input, a [1,300,4] box output, a
+ * [1,300,80] logits output and optionally a [1,300,256] query feature output.
+ */
+static std::shared_ptr<ov::Model> make_raw_model(bool extra_output) {
+    auto image = std::make_shared<ov::opset8::Parameter>(ov::element::f32, ov::Shape{ 1, 3, 640, 640 });
+    image->output(0).get_tensor().set_names({ "image" });
+    ov::ResultVector results;
+    auto add_output = [&results](const std::string& name, size_t dim) {
+        auto value = ov::opset8::Constant::create(ov::element::f32, ov::Shape{ 1, 300, dim }, { 0.0f });
+        value->output(0).get_tensor().set_names({ name });
+        results.push_back(std::make_shared<ov::opset8::Result>(value));
+    };
+    add_output("bboxes", 4);
+    add_output("logits", 80);
+    if (extra_output) {
+        add_output("query_feats", 256);
+    }
+    return std::make_shared<ov::Model>(results, ov::ParameterVector{ image });
+}
+
+static bool throws(const std::function<void()>& f) {
+    try {
+        f();
+    }
+    catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+static void check_roles(const ModelInfo& info) {
+    CHECK(info.image_input == "image");
+    CHECK(info.bbox_index == 0);
+    CHECK(info.score_index == 1);
+    CHECK(info.num_queries == 300);
+    CHECK(info.num_classes == 80);
+    CHECK(info.input_size == cv::Size(640, 640));
+}
+
+int main() {
+    // Two rank 3 outputs are told apart by their shapes alone.
+    check_roles(read_model_info(make_raw_model(false), false));
+
+    std::shared_ptr<ov::Model> model = make_raw_model(true);
+    CHECK(throws([&] { read_model_info(model, false); }));
+
+    // The bundle names both head outputs, nothing is inferred from the ambiguous shapes.
+    ModelBundle bundle = ModelBundle::from_paths("model.xml", "", false);
+    bundle.score_output = "logits";
+    bundle.bbox_output = "bboxes";
+    check_roles(read_bundle_model_info(model, bundle));
+
+    // The bundle names the scores, the boxes are the only remaining [N,Q,4] output.
+    bundle.bbox_output.clear();
+    check_roles(read_bundle_model_info(model, bundle));
+
+    // The bundle names the boxes, two outputs remain for the scores.
+    bundle.score_output.clear();
+    bundle.bbox_output = "bboxes";
+    CHECK(throws([&] { read_bundle_model_info(model, bundle); }));
+
+    // A name that is not in the model is an error.
+    bundle.score_output = "scores";
+    CHECK(throws([&] { read_bundle_model_info(model, bundle); }));
+
+    return test_result("model_info_test");
+}
@@ -0,0 +1,122 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  22:14:36
+// @Brief  : This is the decode test.
+// @File    : process_test.cpp
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : Checks the filter of the raw head decode pass on hand-built logits and boxes: the
+//                per-class thresholds, the class allow-list and the top-k limit, which queries are
+//                kept and in what order. A query whose top class is filtered out must be dropped,
+//                not demoted to its next best class.
+
+#include <cmath>
+#include <vector>
+
+#include "opencv2/opencv.hpp"
+#include "process.h"
+#include "test_check.h"
+
+
+static const int NUM_QUERIES = 6;
+static const int IMAGE_WIDTH = 200, IMAGE_HEIGHT = 100;
+
+/**
+ * The function builds the [6, nc] logits. Every query has one or two classes above the default
+ * threshold of 0.5 (logit 0), the other classes are at -5:
+ *   q0: class 2 at 3.0             q3: nothing above the threshold
+ *   q1: class 1 at 1.0             q4: class 0 at 4.0, class 3 at 2.5
+ *   q2: class 4 at 2.0, 3 at 1.5   q5: class 3 at 0.5
+ * Classes from 5 on only pad the row, to run the generic kernel.
+ */
+static std::vector<float> make_logits(int nc) {
+    std::vector<float> logits(NUM_QUERIES * nc, -5.0f);
+    auto set = [&logits, nc](int query, int clsid, float logit) { logits[query * nc + clsid] = logit; };
+    set(0, 2, 3.0f);
+    set(1, 1, 1.0f);
+    set(2, 4, 2.0f);
+    set(2, 3, 1.5f);
+    set(3, 0, -1.0f);
+    set(4, 0, 4.0f);
+    set(4, 3, 2.5f);
+    set(5, 3, 0.5f);
+    return logits;
+}
+
+/**
+ * The function builds the [6, 4] normalized [cx, cy, w, h] boxes. Query q is centred at
+ * x = 20 * (q + 1) in the 200 x 100 image, so a kept box tells which query it came from.
+ */
+static std::vector<float> make_boxes() {
+    std::vector<float> boxes;
+    for (int q = 0; q < NUM_QUERIES; ++q) {
+        boxes.insert(boxes.end(), { 0.1f * (q + 1), 0.5f, 0.05f, 0.2f });
+    }
+    return boxes;
+}
+
+static int query_of(const cv::Rect& box) {
+    return (int)std::lround((box.x + box.width / 2.0) / 20.0) - 1;
+}
+
+static float sigmoid(float logit) {
+    return 1.0f / (1.0f + std::exp(-logit));
+}
+
+/**
+ * The function decodes the hand-built outputs with the filter and checks the kept queries, their
+ * classes and scores, in order.
+ */
+static void check_decode(int nc, const FilterConfig& filter, const std::vector<int>& queries,
+    const std::vector<int>& clsids, const std::vector<float>& logits) {
+    RTDETRProcess process(cv::Size(32, 32));
+    process.set_output_dims(NUM_QUERIES, nc);
+    process.set_filter(filter);
+    process.preprocess(cv::Mat(IMAGE_HEIGHT, IMAGE_WIDTH, CV_8UC3, cv::Scalar(0, 0, 0)));
+    std::vector<float> score = make_logits(nc);
+    std::vector<float> bbox = make_boxes();
+    ResultData result = process.postprocess(score.data(), bbox.data(), false);
+    CHECK(result.clsids.size() == queries.size());
+    if (result.clsids.size() != queries.size()) {
+        return;
+    }
+    for (size_t i = 0; i < queries.size(); ++i) {
+        CHECK(query_of(result.bboxs[i]) == queries[i]);
+        CHECK(result.clsids[i] == clsids[i]);
+        CHECK(std::fabs(result.scores[i] - sigmoid(logits[i])) < 1e-6f);
+    }
+}
+
+static void test_filter(int nc) {
+    FilterConfig filter;
+    // Every query above the threshold, in query order.
+    check_decode(nc, filter, { 0, 1, 2, 4, 5 }, { 2, 1, 4, 0, 3 }, { 3.0f, 1.0f, 2.0f, 4.0f, 0.5f });
+
+    // The allow-list drops q2 and q4, whose second best class 3 is allowed.
+    filter.allowed_classes = { 1, 3 };
+    check_decode(nc, filter, { 1, 5 }, { 1, 3 }, { 1.0f, 0.5f });
+
+    // The thresholds 0.99 (logit 4.6) drop q4 and 0.8 (logit 1.39) drop q1, 0.9 (logit 2.2) keeps q0.
+    filter.allowed_classes.clear();
+    filter.class_thresholds = { 0.99f, 0.8f, 0.9f };
+    check_decode(nc, filter, { 0, 2, 5 }, { 2, 4, 3 }, { 3.0f, 2.0f, 0.5f });
+
+    // The top-k limit keeps the highest scores, in descending order.
+    filter.class_thresholds.clear();
+    filter.max_detections = 3;
+    check_decode(nc, filter, { 4, 0, 2 }, { 0, 2, 4 }, { 4.0f, 3.0f, 2.0f });
+
+    // The limit applies after the filter.
+    filter.allowed_classes = { 1, 3 };
+    filter.max_detections = 1;
+    check_decode(nc, filter, { 1 }, { 1 }, { 1.0f });
+}
+
+int main() {
+    // 5 classes run the kernel specialized for the class count, 7 the generic one.
+    test_filter(5);
+    test_filter(7);
+    return test_result("process_test");
+}
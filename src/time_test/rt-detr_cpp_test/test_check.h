@@ -0,0 +1,32 @@
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  10:02:41
+// @Brief  : This is the test helper.
+// @File    : test_check.h
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : The check macro of the regression tests. A failed check prints its expression and
+//                location; `test_result` turns the failures into the exit code seen by ctest.
+#ifndef __TEST_CHECK_H__
+#define __TEST_CHECK_H__
+
+#include <cstdio>
+
+static int test_failures = 0;
+
+#define CHECK(expr) \
+    do { \
+        if (!(expr)) { \
+            std::printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #expr); \
+            ++test_failures; \
+        } \
+    } while (0)
+
+static inline int test_result(const char* name) {
+    std::printf("%s: %s\n", name, test_failures == 0 ? "passed" : "FAILED");
+    return test_failures == 0 ? 0 : 1;
+}
+
+#endif // !__TEST_CHECK_H__
@@ -1,40 +1,117 @@
-﻿#include <iostream>
+// Copyright(©) 2023, Company All Rights Reserved 
+// -*- coding: utf-8 -*-
+// @Time    : 2026/10/19  21:46:20
+// @Brief  : This is the time test.
+// @File    : main.cpp
+// @Version : 1.0
+// @Author  : Yan Guojin
+// @E-mail	: guojin_yjs@cumt.edu.cn
+// @GitHub	: https://github.com/guojin-yan
+// @Description : Times the C++ predictor of src/cpp: the model load, the first request of a cold
+//                predictor, the first request after the warm-up, and the steady-state latency. The
+//                predictor is built once per configuration, so the steady numbers contain no load or
+//                first-inference cost.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
 #include <vector>
+
 #include <opencv2/opencv.hpp>
-#include <openvino/openvino.hpp>
 
-#include "process.h"
 #include "rtdert_predictor.h"
 
 
-void RT_DETR(std::string model_path, std::string image_path, std::string label_path, bool post_flag) {
-    INFO("This is an RT-DETR model deployment case using C++!");
+typedef std::chrono::steady_clock Clock;
+
+static double elapsed_ms(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
 
-    //std::string image_path = "E:\\GitSpace\\RT-DETR-OpenVINO\\image\\000000570688.jpg";
-    //std::string label_path = "E:\\GitSpace\\RT-DETR-OpenVINO\\image\\COCO_lable.txt";
-    cv::Mat image = cv::imread(image_path);
-    cv::Mat result_mat;
-    int n = 100;
+struct TimeReport {
+    double load_ms;             // The constructor, including the warm-up if any.
+    double first_ms;            // The first request after the constructor.
+    double mean_ms, p50_ms, p99_ms;
+};
 
-    for (int i = 0; i < n; ++i) {
-        std::cout << "Model predict: " << i << std::endl;
-        //std::string model_path = "E:\\Model\\rtdetr_r50vd_6x_coco.onnx";
-        RTDETRPredictor predictor(model_path, label_path, "CPU", true);
-        result_mat = predictor.predict(image);
+/**
+ * The function builds a predictor, times its first request, then `iterations` steady requests.
+ */
+static TimeReport time_predictor(const std::string& model_path, const std::string& label_path,
+    const std::string& device, bool post_flag, const PredictorOptions& options, const cv::Mat& image,
+    int iterations, WarmupStats& warmup) {
+    TimeReport report;
+    Clock::time_point start = Clock::now();
+    RTDETRPredictor predictor(model_path, label_path, device, post_flag, options);
+    report.load_ms = elapsed_ms(start);
+    warmup = predictor.get_warmup_stats();
+
+    start = Clock::now();
+    predictor.detect(image);
+    report.first_ms = elapsed_ms(start);
+
+    std::vector<double> times;
+    for (int i = 0; i < iterations; ++i) {
+        start = Clock::now();
+        predictor.detect(image);
+        times.push_back(elapsed_ms(start));
+    }
+    std::sort(times.begin(), times.end());
+    report.mean_ms = 0.0;
+    for (double t : times) {
+        report.mean_ms += t / times.size();
     }
-    std::cout << RTDETRPredictor::load_model/n << std::endl;
-    std::cout << RTDETRPredictor::process_image / n << std::endl;
-    std::cout << RTDETRPredictor::load_data / n << std::endl;
-    std::cout << RTDETRPredictor::infer / n << std::endl;
-    std::cout << RTDETRPredictor::post_process / n << std::endl;
+    report.p50_ms = times[times.size() / 2];
+    report.p99_ms = times[std::min(times.size() - 1, times.size() * 99 / 100)];
+    return report;
+}
 
+static void print_report(const char* name, const TimeReport& r) {
+    std::printf("%-26s %10.2f %10.2f %10.2f %10.2f %10.2f %8.2fx\n", name, r.load_ms, r.first_ms, r.mean_ms,
+        r.p50_ms, r.p99_ms, r.first_ms / r.mean_ms);
 }
 
 int main(int argc, char* argv[])
 {
-    RT_DETR("E:\\Model\\RT-DETR\\RTDETR\\rtdetr_r34vd_6x_coco.xml",
-        "E:\\GitSpace\\RT-DETR-OpenVINO\\image\\000000570688.jpg",
-        "E:\\GitSpace\\RT-DETR-OpenVINO\\image\\COCO_lable.txt", true);
-}
+    if (argc < 5) {
+        INFO("Please enter the correct parameters.");
+        INFO("For example:");
+        INFO("  rt-detr_cpp_time_test [model path] [image path] [lable path] [post flag(1/0)] "
+            "[iterations(100)] [warm-up rounds(5)] [device(CPU)]");
+        return 0;
+    }
+    bool post_flag = std::atoi(argv[4]) != 0;
+    int iterations = std::max(argc > 5 ? std::atoi(argv[5]) : 100, 1);
+    int warmup_rounds = argc > 6 ? std::atoi(argv[6]) : 5;
+    std::string device = argc > 7 ? argv[7] : "CPU";
+    cv::Mat image = cv::imread(argv[2]);
+    if (image.empty()) {
+        INFO("Cannot read " << argv[2] << ".");
+        return 1;
+    }
+
+    PredictorOptions cold;
+    cold.warmup_iterations = 0;
+    WarmupStats cold_warmup;
+    TimeReport cold_report = time_predictor(argv[1], argv[3], device, post_flag, cold, image, iterations,
+        cold_warmup);
 
+    PredictorOptions warm;
+    warm.warmup_iterations = warmup_rounds;
+    warm.prefault_weights = true;
+    WarmupStats warm_warmup;
+    TimeReport warm_report = time_predictor(argv[1], argv[3], device, post_flag, warm, image, iterations,
+        warm_warmup);
 
+    std::printf("\n%-26s %10s %10s %10s %10s %10s %9s\n", "(ms)", "load", "first", "mean", "p50", "p99",
+        "first/mean");
+    print_report("cold", cold_report);
+    print_report("warmed up", warm_report);
+    std::printf("\nwarm-up: %d rounds in %.2f ms, first inference %.2f ms, last %.2f ms\n",
+        warm_warmup.iterations, warm_warmup.warmup_ms, warm_warmup.first_ms, warm_warmup.steady_ms);
+    std::printf("prefault: %.1f MB in %.2f ms\n", warm_warmup.prefault_bytes / 1048576.0,
+        warm_warmup.prefault_ms);
+    return 0;
+}